@@ -0,0 +1,678 @@
+#include <stdlib.h>
+#include <string.h>
+
+#include "btree.h"
+#include "../Common/error.h"
+
+// Minimum number of elements or children of every node except the root
+#define BTREE_MIN_COUNT (BTREE_CAPACITY / 2)
+
+/*
+    - Part shared by leaves and internal nodes
+
+    - In a leaf keys holds the elements, in an internal node keys[i] is the
+      smallest element under children[i], so keys[0] is always the smallest
+      element under any node
+*/
+typedef struct {
+    bool leaf;
+    int count;
+    BTreeElement keys[BTREE_CAPACITY];
+}BTREENODE;
+
+typedef struct btreeleaf {
+    BTREENODE node;
+    struct btreeleaf *previous, *next;
+}BTREELEAF;
+
+typedef struct {
+    BTREENODE node;
+    BTREENODE *children[BTREE_CAPACITY];
+}BTREEINTERNAL;
+
+typedef struct {
+    CompareElementsBST compare;
+    int size, height;
+    BTREENODE *root;
+    Pool leaves, internals;
+}BTREE;
+
+BTree newBTree(CompareElementsBST compare) {
+    if(PARAMETER_CHECK(!compare)) {
+        reportError("WARNING: Invalid parameter -- newBTree --\n");
+        return NULL;
+    }
+
+    BTREE *tree = (BTREE *) malloc(sizeof(BTREE));
+    if(!tree) {
+        reportError("ERROR: Could not allocate memory for new BTree -- newBTree --\n");
+        return NULL;
+    }
+
+    tree->leaves = newPool(sizeof(BTREELEAF), NULL, NULL, NULL);
+    tree->internals = newPool(sizeof(BTREEINTERNAL), NULL, NULL, NULL);
+    if(!tree->leaves || !tree->internals) {
+        reportError("ERROR: Could not allocate memory for new BTree -- newBTree --\n");
+        destroyPool(tree->leaves);
+        destroyPool(tree->internals);
+        free(tree);
+        return NULL;
+    }
+
+    tree->compare = compare;
+    tree->size = 0;
+    tree->height = 0;
+    tree->root = NULL;
+
+    return tree;
+}
+
+bool isBTreeEmpty(BTree btree) {
+    if(PARAMETER_CHECK(!btree)) {
+        reportError("WARNING: Invalid parameter -- isBTreeEmpty --\n");
+        return true;
+    }
+
+    return getBTreeSize(btree) == 0;
+}
+
+int getBTreeSize(BTree btree) {
+    if(PARAMETER_CHECK(!btree)) {
+        reportError("WARNING: Invalid parameter -- getBTreeSize --\n");
+        return 0;
+    }
+
+    BTREE *tree = (BTREE *) btree;
+
+    return tree->size;
+}
+
+int getBTreeHeight(BTree btree) {
+    if(PARAMETER_CHECK(!btree)) {
+        reportError("WARNING: Invalid parameter -- getBTreeHeight --\n");
+        return 0;
+    }
+
+    BTREE *tree = (BTREE *) btree;
+
+    return tree->height;
+}
+
+/*
+    # Input:
+        - tree: BTree
+    
+    # Description:
+        - Returns a pointer to a new empty leaf, not linked to any other leaf
+*/
+BTREELEAF *newBTreeLeaf(BTREE *tree) {
+    BTREELEAF *leaf = (BTREELEAF *) allocatePool(tree->leaves);
+    if(!leaf) {
+        reportError("ERROR: Could not allocate memory for new leaf -- newBTreeLeaf --\n");
+        return NULL;
+    }
+
+    leaf->node.leaf = true;
+    leaf->node.count = 0;
+    leaf->previous = NULL;
+    leaf->next = NULL;
+
+    return leaf;
+}
+
+/*
+    # Input:
+        - tree: BTree
+    
+    # Description:
+        - Returns a pointer to a new internal node without children
+*/
+BTREEINTERNAL *newBTreeInternal(BTREE *tree) {
+    BTREEINTERNAL *internal = (BTREEINTERNAL *) allocatePool(tree->internals);
+    if(!internal) {
+        reportError("ERROR: Could not allocate memory for new internal node -- newBTreeInternal --\n");
+        return NULL;
+    }
+
+    internal->node.leaf = false;
+    internal->node.count = 0;
+
+    return internal;
+}
+
+/*
+    # Input:
+        - tree: BTree
+        - node: Node from tree
+    
+    # Description:
+        - Frees node, a leaf is unlinked from its neighbours first
+*/
+void freeBTreeNode(BTREE *tree, BTREENODE *node) {
+    if(node->leaf) {
+        BTREELEAF *leaf = (BTREELEAF *) node;
+
+        if(leaf->previous) leaf->previous->next = leaf->next;
+        if(leaf->next) leaf->next->previous = leaf->previous;
+
+        freePool(tree->leaves, leaf);
+    }
+    else freePool(tree->internals, node);
+}
+
+/*
+    # Input:
+        - tree: BTree
+        - leaf: Leaf from tree
+        - element: Element to be compared
+    
+    # Description:
+        - Returns the index of the first element of leaf that is >= element,
+          or leaf.count if there is none
+*/
+int findBTreeLeafPosition(BTREE *tree, BTREENODE *leaf, BTreeElement element) {
+    int lo = 0, hi = leaf->count;
+
+    while(lo < hi) {
+        int mid = (lo + hi) / 2;
+
+        if(tree->compare(leaf->keys[mid], element) < 0) lo = mid + 1;
+        else hi = mid;
+    }
+
+    return lo;
+}
+
+/*
+    # Input:
+        - tree: BTree
+        - internal: Internal node from tree
+        - element: Element to be compared
+    
+    # Description:
+        - Returns the index of the child of internal that may hold element
+*/
+int findBTreeChild(BTREE *tree, BTREENODE *internal, BTreeElement element) {
+    int lo = 1, hi = internal->count;
+
+    while(lo < hi) {
+        int mid = (lo + hi) / 2;
+
+        if(tree->compare(internal->keys[mid], element) <= 0) lo = mid + 1;
+        else hi = mid;
+    }
+
+    return lo - 1;
+}
+
+/*
+    # Input:
+        - tree: BTree
+        - element: Element to be compared
+    
+    # Description:
+        - Returns the leaf of tree that may hold element
+*/
+BTREELEAF *findBTreeLeaf(BTREE *tree, BTreeElement element) {
+    BTREENODE *node = tree->root;
+
+    while(!node->leaf) node = ((BTREEINTERNAL *) node)->children[findBTreeChild(tree, node, element)];
+
+    return (BTREELEAF *) node;
+}
+
+/*
+    # Input:
+        - node: Full node from a BTree
+        - half: New empty node of the same kind as node
+    
+    # Description:
+        - Moves the upper half of node to half and places half right after it
+*/
+void splitBTreeNode(BTREENODE *node, BTREENODE *half) {
+    if(node->leaf) {
+        BTREELEAF *leaf = (BTREELEAF *) node;
+        BTREELEAF *newLeaf = (BTREELEAF *) half;
+
+        newLeaf->previous = leaf;
+        newLeaf->next = leaf->next;
+        if(leaf->next) leaf->next->previous = newLeaf;
+        leaf->next = newLeaf;
+    }
+    else memcpy(((BTREEINTERNAL *) half)->children, ((BTREEINTERNAL *) node)->children + BTREE_MIN_COUNT, (node->count - BTREE_MIN_COUNT) * sizeof(BTREENODE *));
+
+    half->count = node->count - BTREE_MIN_COUNT;
+    memcpy(half->keys, node->keys + BTREE_MIN_COUNT, half->count * sizeof(BTreeElement));
+
+    node->count = BTREE_MIN_COUNT;
+}
+
+/*
+    # Input:
+        - tree: BTree
+        - count: Number of internal nodes
+        - spares: List of internal nodes linked by their first child
+    
+    # Description:
+        - Adds count new internal nodes to spares
+
+        - Returns false, and frees the nodes of spares, if memory could not be allocated
+*/
+bool allocateBTreeSpares(BTREE *tree, int count, BTREEINTERNAL **spares) {
+    for(int i = 0; i < count; i++) {
+        BTREEINTERNAL *internal = newBTreeInternal(tree);
+
+        if(!internal) {
+            while(*spares) {
+                BTREEINTERNAL *next = (BTREEINTERNAL *) (*spares)->children[0];
+                freePool(tree->internals, *spares);
+                *spares = next;
+            }
+
+            return false;
+        }
+
+        internal->children[0] = (BTREENODE *) *spares;
+        *spares = internal;
+    }
+
+    return true;
+}
+
+/*
+    # Input:
+        - spares: List of internal nodes linked by their first child, not empty
+    
+    # Description:
+        - Removes the first node of spares and returns it
+*/
+BTREEINTERNAL *takeBTreeSpare(BTREEINTERNAL **spares) {
+    BTREEINTERNAL *internal = *spares;
+    *spares = (BTREEINTERNAL *) internal->children[0];
+
+    return internal;
+}
+
+/*
+    # Input:
+        - internal: Internal node with room for one more child
+        - index: Index where child is placed
+        - child: Node to be placed
+        - key: Smallest element under child
+    
+    # Description:
+        - Inserts child and its key at index in internal
+*/
+void insertBTreeChild(BTREEINTERNAL *internal, int index, BTREENODE *child, BTreeElement key) {
+    int count = internal->node.count;
+
+    memmove(internal->children + index + 1, internal->children + index, (count - index) * sizeof(BTREENODE *));
+    memmove(internal->node.keys + index + 1, internal->node.keys + index, (count - index) * sizeof(BTreeElement));
+
+    internal->children[index] = child;
+    internal->node.keys[index] = key;
+    internal->node.count++;
+}
+
+/*
+    # Input:
+        - tree: BTree
+        - node: Root of the subtree where element is inserted
+        - element: Element to be inserted
+        - splits: Number of internal nodes created above node if node is split
+        - spares: Where the internal nodes for those splits are stored
+        - inserted: Set to true if element was inserted
+    
+    # Description:
+        - Inserts element in the subtree rooted at node
+
+        - If node had to be split, returns the new node that holds its
+          upper half, otherwise returns NULL
+
+        - A full leaf allocates every node its split leads to before it is changed,
+          so if memory could not be allocated nothing is changed
+*/
+BTREENODE *insertBTreeNode(BTREE *tree, BTREENODE *node, BTreeElement element, int splits, BTREEINTERNAL **spares, bool *inserted) {
+    BTREENODE *half = NULL;
+
+    if(node->leaf) {
+        int position = findBTreeLeafPosition(tree, node, element);
+        if(position < node->count && tree->compare(node->keys[position], element) == 0) return NULL;
+
+        if(node->count == BTREE_CAPACITY) {
+            BTREELEAF *newLeaf = newBTreeLeaf(tree);
+            if(!newLeaf) return NULL;
+
+            if(!allocateBTreeSpares(tree, splits, spares)) {
+                freePool(tree->leaves, newLeaf);
+                return NULL;
+            }
+
+            half = &newLeaf->node;
+            splitBTreeNode(node, half);
+
+            if(position > node->count) {
+                position -= node->count;
+                node = half;
+            }
+        }
+
+        memmove(node->keys + position + 1, node->keys + position, (node->count - position) * sizeof(BTreeElement));
+        node->keys[position] = element;
+        node->count++;
+
+        *inserted = true;
+
+        return half;
+    }
+
+    int index = findBTreeChild(tree, node, element);
+    BTREENODE *child = ((BTREEINTERNAL *) node)->children[index];
+
+    // A split of child only splits node too if node is full
+    int childSplits = (node->count == BTREE_CAPACITY) ? splits + 1 : 0;
+
+    BTREENODE *childHalf = insertBTreeNode(tree, child, element, childSplits, spares, inserted);
+
+    node->keys[index] = child->keys[0];
+    if(!childHalf) return NULL;
+
+    if(node->count == BTREE_CAPACITY) {
+        half = &takeBTreeSpare(spares)->node;
+        splitBTreeNode(node, half);
+
+        if(index >= node->count) {
+            index -= node->count;
+            node = half;
+        }
+    }
+
+    insertBTreeChild((BTREEINTERNAL *) node, index + 1, childHalf, childHalf->keys[0]);
+
+    return half;
+}
+
+bool insertBTree(BTree btree, BTreeElement element) {
+    if(PARAMETER_CHECK(!btree || !element)) {
+        reportError("WARNING: Invalid parameters -- insertBTree --\n");
+        return false;
+    }
+
+    BTREE *tree = (BTREE *) btree;
+
+    if(!tree->root) {
+        BTREELEAF *leaf = newBTreeLeaf(tree);
+        if(!leaf) return false;
+
+        tree->root = &leaf->node;
+        tree->height = 1;
+    }
+
+    bool inserted = false;
+    BTREEINTERNAL *spares = NULL;
+
+    // A split of the root needs a new root
+    BTREENODE *half = insertBTreeNode(tree, tree->root, element, 1, &spares, &inserted);
+
+    // The root was split, the tree grows one level
+    if(half) {
+        BTREEINTERNAL *root = takeBTreeSpare(&spares);
+
+        root->children[0] = tree->root;
+        root->children[1] = half;
+        root->node.keys[0] = tree->root->keys[0];
+        root->node.keys[1] = half->keys[0];
+        root->node.count = 2;
+
+        tree->root = &root->node;
+        tree->height++;
+    }
+
+    if(inserted) tree->size++;
+
+    return inserted;
+}
+
+/*
+    # Input:
+        - tree: BTree
+        - internal: Internal node from tree
+        - index: Index of the child to be removed
+    
+    # Description:
+        - Removes the child at index and its key from internal, the child is not freed
+*/
+void removeBTreeChild(BTREEINTERNAL *internal, int index) {
+    int count = --internal->node.count;
+
+    memmove(internal->children + index, internal->children + index + 1, (count - index) * sizeof(BTREENODE *));
+    memmove(internal->node.keys + index, internal->node.keys + index + 1, (count - index) * sizeof(BTreeElement));
+}
+
+/*
+    # Input:
+        - internal: Internal node from a BTree
+        - left: Index of a child of internal
+    
+    # Description:
+        - Moves the first key (and child) of children[left + 1] to the end
+          of children[left]
+*/
+void shiftBTreeLeft(BTREEINTERNAL *internal, int left) {
+    BTREENODE *to = internal->children[left];
+    BTREENODE *from = internal->children[left + 1];
+
+    to->keys[to->count] = from->keys[0];
+    if(!to->leaf) ((BTREEINTERNAL *) to)->children[to->count] = ((BTREEINTERNAL *) from)->children[0];
+    to->count++;
+
+    from->count--;
+    memmove(from->keys, from->keys + 1, from->count * sizeof(BTreeElement));
+    if(!from->leaf) memmove(((BTREEINTERNAL *) from)->children, ((BTREEINTERNAL *) from)->children + 1, from->count * sizeof(BTREENODE *));
+
+    internal->node.keys[left + 1] = from->keys[0];
+}
+
+/*
+    # Input:
+        - internal: Internal node from a BTree
+        - left: Index of a child of internal
+    
+    # Description:
+        - Moves the last key (and child) of children[left] to the start
+          of children[left + 1]
+*/
+void shiftBTreeRight(BTREEINTERNAL *internal, int left) {
+    BTREENODE *from = internal->children[left];
+    BTREENODE *to = internal->children[left + 1];
+
+    memmove(to->keys + 1, to->keys, to->count * sizeof(BTreeElement));
+    if(!to->leaf) memmove(((BTREEINTERNAL *) to)->children + 1, ((BTREEINTERNAL *) to)->children, to->count * sizeof(BTREENODE *));
+
+    from->count--;
+    to->keys[0] = from->keys[from->count];
+    if(!to->leaf) ((BTREEINTERNAL *) to)->children[0] = ((BTREEINTERNAL *) from)->children[from->count];
+    to->count++;
+
+    internal->node.keys[left + 1] = to->keys[0];
+}
+
+/*
+    # Input:
+        - tree: BTree
+        - internal: Internal node from tree
+        - left: Index of a child of internal
+    
+    # Description:
+        - Appends children[left + 1] to children[left] and frees it
+*/
+void mergeBTreeChildren(BTREE *tree, BTREEINTERNAL *internal, int left) {
+    BTREENODE *to = internal->children[left];
+    BTREENODE *from = internal->children[left + 1];
+
+    memcpy(to->keys + to->count, from->keys, from->count * sizeof(BTreeElement));
+    if(!to->leaf) memcpy(((BTREEINTERNAL *) to)->children + to->count, ((BTREEINTERNAL *) from)->children, from->count * sizeof(BTREENODE *));
+    to->count += from->count;
+
+    removeBTreeChild(internal, left + 1);
+    freeBTreeNode(tree, from);
+}
+
+/*
+    # Input:
+        - tree: BTree
+        - internal: Internal node from tree
+        - index: Index of a child of internal with less than BTREE_MIN_COUNT keys
+    
+    # Description:
+        - Refills the child at index borrowing from a sibling, or merges it
+          with a sibling if both are at the minimum
+*/
+void fixBTreeChild(BTREE *tree, BTREEINTERNAL *internal, int index) {
+    int count = internal->node.count;
+
+    if(index > 0 && internal->children[index - 1]->count > BTREE_MIN_COUNT) shiftBTreeRight(internal, index - 1);
+    else if(index + 1 < count && internal->children[index + 1]->count > BTREE_MIN_COUNT) shiftBTreeLeft(internal, index);
+    else if(index > 0) mergeBTreeChildren(tree, internal, index - 1);
+    else if(index + 1 < count) mergeBTreeChildren(tree, internal, index);
+}
+
+/*
+    # Input:
+        - tree: BTree
+        - node: Root of the subtree where element is removed
+        - element: Element to be removed
+    
+    # Description:
+        - Removes the element equal to element from the subtree rooted at node
+          and returns the stored element, or NULL if there is none
+
+        - node may be left with less than BTREE_MIN_COUNT keys, its parent fixes it
+*/
+BTreeElement removeBTreeNode(BTREE *tree, BTREENODE *node, BTreeElement element) {
+    if(node->leaf) {
+        int position = findBTreeLeafPosition(tree, node, element);
+        if(position == node->count || tree->compare(node->keys[position], element) != 0) return NULL;
+
+        BTreeElement removed = node->keys[position];
+
+        node->count--;
+        memmove(node->keys + position, node->keys + position + 1, (node->count - position) * sizeof(BTreeElement));
+
+        return removed;
+    }
+
+    BTREEINTERNAL *internal = (BTREEINTERNAL *) node;
+    int index = findBTreeChild(tree, node, element);
+    BTREENODE *child = internal->children[index];
+
+    BTreeElement removed = removeBTreeNode(tree, child, element);
+    if(!removed) return NULL;
+
+    // The removed element may have been the smallest of child, so its key must not keep pointing to it
+    node->keys[index] = child->keys[0];
+
+    if(child->count < BTREE_MIN_COUNT) fixBTreeChild(tree, internal, index);
+
+    return removed;
+}
+
+BTreeElement removeBTree(BTree btree, BTreeElement element) {
+    if(PARAMETER_CHECK(!btree || !element)) {
+        reportError("WARNING: Invalid parameters -- removeBTree --\n");
+        return NULL;
+    }
+
+    BTREE *tree = (BTREE *) btree;
+    if(!tree->root) return NULL;
+
+    BTreeElement removed = removeBTreeNode(tree, tree->root, element);
+    if(!removed) return NULL;
+
+    tree->size--;
+
+    // The tree shrinks one level when the root is left with a single child
+    BTREENODE *root = tree->root;
+    if(!root->leaf && root->count == 1) {
+        tree->root = ((BTREEINTERNAL *) root)->children[0];
+        tree->height--;
+
+        freeBTreeNode(tree, root);
+    }
+    else if(root->leaf && !root->count) {
+        tree->root = NULL;
+        tree->height = 0;
+
+        freeBTreeNode(tree, root);
+    }
+
+    return removed;
+}
+
+BTreeElement findBTreeElement(BTree btree, BTreeElement element) {
+    if(PARAMETER_CHECK(!btree || !element)) {
+        reportError("WARNING: Invalid parameters -- findBTreeElement --\n");
+        return NULL;
+    }
+
+    BTREE *tree = (BTREE *) btree;
+    if(!tree->root) return NULL;
+
+    BTREENODE *leaf = &findBTreeLeaf(tree, element)->node;
+    int position = findBTreeLeafPosition(tree, leaf, element);
+
+    if(position == leaf->count || tree->compare(leaf->keys[position], element) != 0) return NULL;
+
+    return leaf->keys[position];
+}
+
+void rangeBTree(BTree btree, BTreeElement lo, BTreeElement hi, VisitBTreeElement visit, void *extra) {
+    if(PARAMETER_CHECK(!btree || !lo || !hi)) {
+        reportError("WARNING: Invalid parameters -- rangeBTree --\n");
+        return;
+    }
+
+    BTREE *tree = (BTREE *) btree;
+    if(!tree->root) return;
+
+    BTREELEAF *leaf = findBTreeLeaf(tree, lo);
+    int position = findBTreeLeafPosition(tree, &leaf->node, lo);
+
+    for(; leaf; leaf = leaf->next, position = 0) {
+        for(; position < leaf->node.count; position++) {
+            if(tree->compare(leaf->node.keys[position], hi) >= 0) return;
+            if(visit && visit(btree, leaf->node.keys[position], extra)) return;
+        }
+    }
+}
+
+void inOrderBTreeTraversal(BTree btree, VisitBTreeElement visit, void *extra) {
+    if(PARAMETER_CHECK(!btree)) {
+        reportError("WARNING: Invalid parameter -- inOrderBTreeTraversal --\n");
+        return;
+    }
+
+    BTREE *tree = (BTREE *) btree;
+    if(!tree->root || !visit) return;
+
+    BTREENODE *node = tree->root;
+    while(!node->leaf) node = ((BTREEINTERNAL *) node)->children[0];
+
+    for(BTREELEAF *leaf = (BTREELEAF *) node; leaf; leaf = leaf->next) {
+        for(int i = 0; i < leaf->node.count; i++) {
+            if(visit(btree, leaf->node.keys[i], extra)) return;
+        }
+    }
+}
+
+void destroyBTree(BTree btree) {
+    if(!btree) return;
+
+    BTREE *tree = (BTREE *) btree;
+
+    destroyPool(tree->leaves);
+    destroyPool(tree->internals);
+
+    free(tree);
+    btree = NULL;
+}
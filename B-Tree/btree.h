@@ -0,0 +1,159 @@
+#ifndef BTREE_H
+#define BTREE_H
+
+/*
+    - This module implements a B+ tree
+
+    - A B+ tree is a balanced search tree with a high fanout:
+        - Every element is stored in a leaf, each leaf holds up to BTREE_CAPACITY elements in sorted order
+        - Internal nodes hold up to BTREE_CAPACITY children and the keys that separate them
+        - Every leaf is at the same depth and every node except the root is at least half full
+        - Leaves are linked in order, so range scans and traversals walk the leaves directly
+
+    - Nodes are arrays of element pointers, a lookup does one binary search per level and the tree is
+      only O(log n / log BTREE_CAPACITY) levels deep, which costs far fewer cache misses than a BST
+
+    - Elements are compared with the same CompareElementsBST function used by the BST module and
+      the elements of a BTree are unique, an element equal to a stored one is not inserted
+
+    - A valid element is a BTreeElement != NULL
+
+    - In this module its assumed BTree != NULL and BTreeElement != NULL for functions that recieve
+      those as parameters 
+
+    - Parameter checks are compiled out when DS_NO_CHECKS is defined (see Common/error.h)
+
+    - It's necessary to free the memory allocated for BTree using the functions provided in this module
+*/
+
+#include <stdbool.h>
+
+#include "../Binary Search Tree/bst.h"
+
+// Maximum number of elements in a leaf and of children in an internal node
+#define BTREE_CAPACITY 32
+
+typedef void *BTree;
+typedef void *BTreeElement;
+
+/*
+    - Function utilized by the traversal functions
+
+    - If this function returns true, the traversal will stop
+*/
+typedef bool (* VisitBTreeElement)(BTree btree, BTreeElement element, void *extra);
+
+/*
+    # Input:
+        - compare: Function to compare BTreeElement for new BTree
+    
+    # Description:
+        - Returns a pointer to a new empty BTree
+*/
+BTree newBTree(CompareElementsBST compare);
+
+/*
+    # Input:
+        - btree: BTree
+    
+    # Description:
+        - Returns true if btree is empty, false otherwise
+*/
+bool isBTreeEmpty(BTree btree);
+
+/*
+    # Input:
+        - btree: BTree
+    
+    # Description:
+        - Returns the number of elements stored in btree
+*/
+int getBTreeSize(BTree btree);
+
+/*
+    # Input:
+        - btree: BTree
+    
+    # Description:
+        - Returns the number of levels of btree, 0 if btree is empty
+*/
+int getBTreeHeight(BTree btree);
+
+/*
+    # Input:
+        - btree: BTree
+        - element: Element to be inserted
+    
+    # Description:
+        - Inserts element in btree
+
+        - Returns false if an element equal to element is already stored
+          or element could not be inserted, btree is then not changed
+*/
+bool insertBTree(BTree btree, BTreeElement element);
+
+/*
+    # Input:
+        - btree: BTree
+        - element: Element to be removed
+    
+    # Description:
+        - Removes the element equal to element from btree and returns
+          the element that was stored
+
+        - If there is no such element, returns NULL
+*/
+BTreeElement removeBTree(BTree btree, BTreeElement element);
+
+/*
+    # Input:
+        - btree: BTree
+        - element: Searched element
+    
+    # Description:
+        - Returns the stored element equal to element
+
+        - If element is not in btree, returns NULL
+*/
+BTreeElement findBTreeElement(BTree btree, BTreeElement element);
+
+/*
+    # Input:
+        - btree: BTree
+        - lo: Lower bound of the range, inclusive
+        - hi: Upper bound of the range, exclusive
+        - visit: Function to be used during the traversal
+        - extra: Extra pointer if necessary
+    
+    # Description:
+        - Visits in order every element of btree in [lo, hi)
+
+        - Only the path to lo and the leaves holding the range are read
+
+        - visit and extra can be NULL
+*/
+void rangeBTree(BTree btree, BTreeElement lo, BTreeElement hi, VisitBTreeElement visit, void *extra);
+
+/*
+    # Input:
+        - btree: BTree
+        - visit: Function to be used during the traversal
+        - extra: Extra pointer if necessary
+    
+    # Description:
+        - Traverse btree in order, walking the linked leaves
+
+        - visit and extra can be NULL
+*/
+void inOrderBTreeTraversal(BTree btree, VisitBTreeElement visit, void *extra);
+
+/*
+    # Input:
+        - btree: BTree
+    
+    # Description:
+        - Free all the memory used by btree
+*/
+void destroyBTree(BTree btree);
+
+#endif
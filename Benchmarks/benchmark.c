@@ -0,0 +1,1110 @@
+/*
+    - Microbenchmarks for the List, BST and BTree modules
+
+    - Usage: benchmark [max exponent] [name filter]
+        - Every benchmark runs for n = 10^3, 10^4, ..., 10^(max exponent), default max exponent is 6
+        - Only benchmarks whose name contains name filter are run
+
+    - Each benchmark runs in its own process, so the reported peak RSS belongs to that benchmark only
+
+    - Results are printed as one JSON object per line:
+      {"benchmark": "bst_insert", "pattern": "random", "n": 1000, "ops": 1000, "ns_per_op": 85.2,
+       "ops_per_sec": 11737089.2, "peak_rss_kb": 1520}
+
+    - Errors, including the ones reported by the modules, are printed to stderr
+*/
+
+#define _POSIX_C_SOURCE 200809L
+
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <sys/resource.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include "../List/list.h"
+#include "../List/ulist.h"
+#include "../List/clist.h"
+#include "../List/deque.h"
+#include "../List/list_generic.h"
+#include "../Binary Search Tree/bst.h"
+#include "../Binary Search Tree/cbst.h"
+#include "../Binary Search Tree/pbst.h"
+#include "../Binary Search Tree/ibst.h"
+#include "../Binary Search Tree/bst_generic.h"
+#include "../Binary Search Tree/bst_mmap.h"
+#include "../B-Tree/btree.h"
+#include "../Common/error.h"
+
+// Number of operations timed by benchmarks that are O(n) per operation
+#define BENCHMARK_SLOW_OPS 1000
+
+// Number of elements kept in the queues of the queue benchmarks
+#define BENCHMARK_QUEUE 1000
+
+// Number of lookups given to each call of the batched lookups
+#define BENCHMARK_BATCH 1024
+
+// Number of keys of the unbalanced BST joined to a balanced one, below the height
+// where unionBST stops recursing
+#define BENCHMARK_UNBALANCED 100
+
+// Number of producer and of consumer threads in the concurrent benchmarks
+#define BENCHMARK_THREADS 4
+
+typedef enum {SEQUENTIAL, RANDOM, SORTED, REVERSED} PATTERN;
+
+const char *patternNames[] = {"sequential", "random", "sorted", "reversed"};
+
+/*
+    - A benchmark receives n keys in the order given by its pattern, prepares
+      its data structure, times the measured operation and returns the number
+      of operations timed, storing the elapsed time in seconds
+*/
+typedef long (* RunBenchmark)(long n, long *keys, double *seconds);
+
+typedef struct {
+    const char *name;
+    PATTERN pattern;
+    long maxN;  // Larger n are skipped, 0 if there is no limit
+    RunBenchmark run;
+}BENCHMARK;
+
+/*
+    # Description:
+        - Returns a monotonic time in seconds
+*/
+double now() {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+/*
+    # Input:
+        - state: State of the generator, must not be 0
+    
+    # Description:
+        - Returns the next number of a xorshift generator, so every run
+          uses the same random sequence
+*/
+unsigned long long nextRandom(unsigned long long *state) {
+    *state ^= *state << 13;
+    *state ^= *state >> 7;
+    *state ^= *state << 17;
+
+    return *state;
+}
+
+/*
+    # Input:
+        - n: Number of keys
+        - pattern: Order of the keys
+    
+    # Description:
+        - Returns an array with the keys 0..n-1 in the order of pattern
+*/
+long *newKeys(long n, PATTERN pattern) {
+    long *keys = (long *) malloc(n * sizeof(long));
+    if(!keys) return NULL;
+
+    for(long i = 0; i < n; i++) keys[i] = (pattern == REVERSED) ? n - 1 - i : i;
+
+    if(pattern == RANDOM) {
+        unsigned long long state = 88172645463325252ULL;
+
+        for(long i = n - 1; i > 0; i--) {
+            long j = nextRandom(&state) % (i + 1);
+            long temp = keys[i];
+            keys[i] = keys[j];
+            keys[j] = temp;
+        }
+    }
+
+    return keys;
+}
+
+int compareKeys(BSTElement el1, BSTElement el2) {
+    long k1 = *(long *) el1, k2 = *(long *) el2;
+
+    return (k1 > k2) - (k1 < k2);
+}
+
+bool visitBSTNode(BST bst, BSTNode node, void *extra) {
+    (void) bst;
+    *(long *) extra += *(long *) getBSTNodeElement(node);
+
+    return false;
+}
+
+const void *serializeKey(BSTElement element, size_t *size, void *extra) {
+    (void) extra;
+    *size = sizeof(long);
+
+    return element;
+}
+
+void reduceBSTNode(BSTNode node, void *accumulator, void *extra) {
+    (void) extra;
+    *(long *) accumulator += *(long *) getBSTNodeElement(node);
+}
+
+void combineBSTSums(void *accumulator, void *other, void *extra) {
+    (void) extra;
+    *(long *) accumulator += *(long *) other;
+}
+
+bool visitBTreeElement(BTree btree, BTreeElement element, void *extra) {
+    (void) btree;
+    *(long *) extra += *(long *) element;
+
+    return false;
+}
+
+bool visitUListElement(UList ulist, ListElement element, void *extra) {
+    (void) ulist;
+    *(long *) extra += *(long *) element;
+
+    return false;
+}
+
+bool visitDequeElement(Deque deque, ListElement element, void *extra) {
+    (void) deque;
+    *(long *) extra += *(long *) element;
+
+    return false;
+}
+
+// Sink for computed values, so the compiler cannot drop the measured loops
+volatile long benchmarkSink;
+
+// --- List ---
+
+long listPush(long n, long *keys, double *seconds) {
+    List list = newList();
+
+    double start = now();
+    for(long i = 0; i < n; i++) pushList(list, &keys[i]);
+    *seconds = now() - start;
+
+    destroyList(list);
+    return n;
+}
+
+long listInsertEnd(long n, long *keys, double *seconds) {
+    List list = newList();
+
+    double start = now();
+    for(long i = 0; i < n; i++) insertEndList(list, &keys[i]);
+    *seconds = now() - start;
+
+    destroyList(list);
+    return n;
+}
+
+long listPop(long n, long *keys, double *seconds) {
+    List list = newList();
+    for(long i = 0; i < n; i++) insertEndList(list, &keys[i]);
+
+    double start = now();
+    for(long i = 0; i < n; i++) pop(list);
+    *seconds = now() - start;
+
+    destroyList(list);
+    return n;
+}
+
+/*
+    # Description:
+        - Times n rounds of inserting at the end and popping from the start
+          of a queue that holds BENCHMARK_QUEUE elements
+*/
+long listQueue(long n, long *keys, double *seconds) {
+    List list = newList();
+    for(long i = 0; i < BENCHMARK_QUEUE; i++) insertEndList(list, &keys[i % n]);
+
+    double start = now();
+    for(long i = 0; i < n; i++) {
+        insertEndList(list, &keys[i]);
+        pop(list);
+    }
+    *seconds = now() - start;
+
+    destroyList(list);
+    return n;
+}
+
+/*
+    # Description:
+        - Moves every element between 2 queues made with newList,
+          each queue holds BENCHMARK_QUEUE elements before being moved
+*/
+long listConcat(long n, long *keys, double *seconds) {
+    List lists[2];
+    lists[0] = newList();
+    lists[1] = newList();
+    for(long i = 0; i < BENCHMARK_QUEUE; i++) insertEndList(lists[0], &keys[i % n]);
+
+    double start = now();
+    for(long i = 0; i < n; i++) concatList(lists[(i + 1) % 2], lists[i % 2]);
+    *seconds = now() - start;
+
+    destroyList(lists[0]);
+    destroyList(lists[1]);
+    return n;
+}
+
+long listInsertPosition(long n, long *keys, double *seconds) {
+    List list = newList();
+    for(long i = 0; i < n; i++) insertEndList(list, &keys[i]);
+
+    long ops = (n < BENCHMARK_SLOW_OPS) ? n : BENCHMARK_SLOW_OPS;
+
+    double start = now();
+    for(long i = 0; i < ops; i++) insertList(list, &keys[i], keys[i] % n);
+    *seconds = now() - start;
+
+    destroyList(list);
+    return ops;
+}
+
+long listRemovePosition(long n, long *keys, double *seconds) {
+    List list = newList();
+    for(long i = 0; i < n; i++) insertEndList(list, &keys[i]);
+
+    long ops = (n < BENCHMARK_SLOW_OPS) ? n : BENCHMARK_SLOW_OPS;
+
+    double start = now();
+    for(long i = 0; i < ops; i++) removeList(list, keys[i] % (n - i));
+    *seconds = now() - start;
+
+    destroyList(list);
+    return ops;
+}
+
+long listTraverse(long n, long *keys, double *seconds) {
+    List list = newList();
+    for(long i = 0; i < n; i++) insertEndList(list, &keys[i]);
+
+    long sum = 0;
+
+    double start = now();
+    for(ListNode node = getFirstListNode(list); node; node = getNextListNode(list, node)) sum += *(long *) getListNodeElement(list, node);
+    *seconds = now() - start;
+
+    benchmarkSink = sum;
+
+    destroyList(list);
+    return n;
+}
+
+long listSort(long n, long *keys, double *seconds) {
+    List list = newList();
+    for(long i = 0; i < n; i++) insertEndList(list, &keys[i]);
+
+    double start = now();
+    sortList(list, compareKeys);
+    *seconds = now() - start;
+
+    destroyList(list);
+    return n;
+}
+
+long listDestroy(long n, long *keys, double *seconds) {
+    List list = newList();
+    for(long i = 0; i < n; i++) insertEndList(list, &keys[i]);
+
+    double start = now();
+    destroyList(list);
+    *seconds = now() - start;
+
+    return n;
+}
+
+// --- UList ---
+
+long ulistInsertEnd(long n, long *keys, double *seconds) {
+    UList ulist = newUList();
+
+    double start = now();
+    for(long i = 0; i < n; i++) insertEndUList(ulist, &keys[i]);
+    *seconds = now() - start;
+
+    destroyUList(ulist);
+    return n;
+}
+
+long ulistTraverse(long n, long *keys, double *seconds) {
+    UList ulist = newUList();
+    for(long i = 0; i < n; i++) insertEndUList(ulist, &keys[i]);
+
+    long sum = 0;
+
+    double start = now();
+    traverseUList(ulist, visitUListElement, &sum);
+    *seconds = now() - start;
+
+    benchmarkSink = sum;
+
+    destroyUList(ulist);
+    return n;
+}
+
+// --- Deque ---
+
+long dequeInsertEnd(long n, long *keys, double *seconds) {
+    Deque deque = newDeque();
+
+    double start = now();
+    for(long i = 0; i < n; i++) insertEndDeque(deque, &keys[i]);
+    *seconds = now() - start;
+
+    destroyDeque(deque);
+    return n;
+}
+
+/*
+    # Description:
+        - Same as listQueue, with a deque
+*/
+long dequeQueue(long n, long *keys, double *seconds) {
+    Deque deque = newDeque();
+    for(long i = 0; i < BENCHMARK_QUEUE; i++) insertEndDeque(deque, &keys[i % n]);
+
+    double start = now();
+    for(long i = 0; i < n; i++) {
+        insertEndDeque(deque, &keys[i]);
+        popDeque(deque);
+    }
+    *seconds = now() - start;
+
+    destroyDeque(deque);
+    return n;
+}
+
+long dequeTraverse(long n, long *keys, double *seconds) {
+    Deque deque = newDeque();
+    for(long i = 0; i < n; i++) insertEndDeque(deque, &keys[i]);
+
+    long sum = 0;
+
+    double start = now();
+    traverseDeque(deque, visitDequeElement, &sum);
+    *seconds = now() - start;
+
+    benchmarkSink = sum;
+
+    destroyDeque(deque);
+    return n;
+}
+
+// --- CList ---
+
+typedef struct {
+    CList clist;
+    long *keys;
+    long count;
+}CLISTWORK;
+
+void *produceCList(void *extra) {
+    CLISTWORK *work = (CLISTWORK *) extra;
+
+    for(long i = 0; i < work->count; i++) insertEndCList(work->clist, &work->keys[i]);
+
+    return NULL;
+}
+
+void *consumeCList(void *extra) {
+    CLISTWORK *work = (CLISTWORK *) extra;
+
+    for(long i = 0; i < work->count;) {
+        if(popCList(work->clist)) i++;
+    }
+
+    return NULL;
+}
+
+long clistProducerConsumer(long n, long *keys, double *seconds) {
+    CList clist = newCList();
+    pthread_t threads[2 * BENCHMARK_THREADS];
+    CLISTWORK work[BENCHMARK_THREADS];
+
+    long perThread = n / BENCHMARK_THREADS;
+
+    double start = now();
+    for(int i = 0; i < BENCHMARK_THREADS; i++) {
+        work[i] = (CLISTWORK) {clist, keys + i * perThread, perThread};
+
+        pthread_create(&threads[i], NULL, produceCList, &work[i]);
+        pthread_create(&threads[BENCHMARK_THREADS + i], NULL, consumeCList, &work[i]);
+    }
+    for(int i = 0; i < 2 * BENCHMARK_THREADS; i++) pthread_join(threads[i], NULL);
+    *seconds = now() - start;
+
+    destroyCList(clist);
+    return 2 * perThread * BENCHMARK_THREADS;
+}
+
+// --- BST ---
+
+/*
+    # Input:
+        - n: Number of keys
+        - keys: Keys to be inserted
+        - balanced: Type of the BST
+    
+    # Description:
+        - Returns a new BST with the n keys inserted in order
+*/
+BST newBenchmarkBST(long n, long *keys, bool balanced) {
+    BST bst = (balanced) ? newBalancedBST(compareKeys) : newBST(compareKeys);
+    for(long i = 0; i < n; i++) insertBST(bst, &keys[i]);
+
+    return bst;
+}
+
+/*
+    # Description:
+        - Times the insertion of the n keys in a new BST
+*/
+long runBSTInsert(long n, long *keys, double *seconds, bool balanced) {
+    BST bst = (balanced) ? newBalancedBST(compareKeys) : newBST(compareKeys);
+
+    double start = now();
+    for(long i = 0; i < n; i++) insertBST(bst, &keys[i]);
+    *seconds = now() - start;
+
+    destroyBST(bst);
+    return n;
+}
+
+/*
+    # Description:
+        - Times a lookup of each of the n keys, in random order, in a BST built
+          with the keys in the order given
+*/
+long runBSTFind(long n, long *keys, double *seconds, bool balanced) {
+    BST bst = newBenchmarkBST(n, keys, balanced);
+    long *lookups = newKeys(n, RANDOM);
+    long found = 0;
+
+    double start = now();
+    for(long i = 0; i < n; i++) found += findBSTNodeElement(bst, &lookups[i]) != NULL;
+    *seconds = now() - start;
+
+    benchmarkSink = found;
+
+    free(lookups);
+    destroyBST(bst);
+    return n;
+}
+
+long bstInsert(long n, long *keys, double *seconds) {
+    return runBSTInsert(n, keys, seconds, false);
+}
+
+long balancedBSTInsert(long n, long *keys, double *seconds) {
+    return runBSTInsert(n, keys, seconds, true);
+}
+
+long bstFind(long n, long *keys, double *seconds) {
+    return runBSTFind(n, keys, seconds, false);
+}
+
+long balancedBSTFind(long n, long *keys, double *seconds) {
+    return runBSTFind(n, keys, seconds, true);
+}
+
+/*
+    # Description:
+        - Same as balancedBSTFind, looking up the keys in batches of
+          BENCHMARK_BATCH with findBSTBatch
+*/
+long balancedBSTFindBatch(long n, long *keys, double *seconds) {
+    BST bst = newBenchmarkBST(n, keys, true);
+    long *lookups = newKeys(n, RANDOM);
+
+    BSTElement *elements = (BSTElement *) malloc(n * sizeof(BSTElement));
+    for(long i = 0; i < n; i++) elements[i] = &lookups[i];
+
+    BSTNode nodes[BENCHMARK_BATCH];
+    long found = 0;
+
+    double start = now();
+    for(long i = 0; i < n; i += BENCHMARK_BATCH) {
+        int count = (n - i < BENCHMARK_BATCH) ? n - i : BENCHMARK_BATCH;
+
+        found += findBSTBatch(bst, elements + i, count, nodes);
+    }
+    *seconds = now() - start;
+
+    benchmarkSink = found;
+
+    free(elements);
+    free(lookups);
+    destroyBST(bst);
+    return n;
+}
+
+/*
+    # Description:
+        - Same as balancedBSTFind, on the BST frozen with freezeBST before
+          the lookups, the time to freeze it is not measured
+*/
+long balancedBSTFindFrozen(long n, long *keys, double *seconds) {
+    BST bst = newBenchmarkBST(n, keys, true);
+    long *lookups = newKeys(n, RANDOM);
+    long found = 0;
+
+    freezeBST(bst);
+
+    double start = now();
+    for(long i = 0; i < n; i++) found += findBSTNodeElement(bst, &lookups[i]) != NULL;
+    *seconds = now() - start;
+
+    benchmarkSink = found;
+
+    free(lookups);
+    destroyBST(bst);
+    return n;
+}
+
+long balancedBSTInOrder(long n, long *keys, double *seconds) {
+    BST bst = newBenchmarkBST(n, keys, true);
+    long sum = 0;
+
+    double start = now();
+    inOrderBSTTraversal(bst, visitBSTNode, &sum);
+    *seconds = now() - start;
+
+    benchmarkSink = sum;
+
+    destroyBST(bst);
+    return n;
+}
+
+long balancedBSTReduceParallel(long n, long *keys, double *seconds) {
+    BST bst = newBenchmarkBST(n, keys, true);
+    long sums[BENCHMARK_THREADS] = {0};
+
+    double start = now();
+    parallelReduceBST(bst, reduceBSTNode, combineBSTSums, sums, sizeof(long), BENCHMARK_THREADS, NULL);
+    *seconds = now() - start;
+
+    benchmarkSink = sums[0];
+
+    destroyBST(bst);
+    return n;
+}
+
+/*
+    # Description:
+        - Same as balancedBSTFind, on the BST saved to a temporary file
+          and mapped back with mmapBST
+*/
+long mappedBSTFind(long n, long *keys, double *seconds) {
+    char path[] = "/tmp/benchmark_bst_XXXXXX";
+    int fd = mkstemp(path);
+    if(fd < 0) return 0;
+    close(fd);
+
+    BST bst = newBenchmarkBST(n, keys, true);
+    bool saved = saveBST(bst, path, serializeKey, NULL);
+    destroyBST(bst);
+
+    MappedBST mbst = (saved) ? mmapBST(path, compareKeys) : NULL;
+    if(!mbst) {
+        unlink(path);
+        return 0;
+    }
+
+    long *lookups = newKeys(n, RANDOM);
+    long found = 0;
+
+    double start = now();
+    for(long i = 0; i < n; i++) found += findMappedBST(mbst, &lookups[i]) >= 0;
+    *seconds = now() - start;
+
+    benchmarkSink = found;
+
+    free(lookups);
+    closeMappedBST(mbst);
+    unlink(path);
+    return n;
+}
+
+/*
+    # Description:
+        - Times the union of 2 balanced BSTs, each one with half of the keys
+*/
+long runBSTUnion(long n, long *keys, double *seconds, int threads) {
+    BST bst = newBalancedBST(compareKeys);
+    BST other = newBalancedBST(compareKeys);
+    for(long i = 0; i < n; i++) insertBST((i % 2) ? other : bst, &keys[i]);
+
+    double start = now();
+    unionBST(bst, other, threads);
+    *seconds = now() - start;
+
+    destroyBST(other);
+    destroyBST(bst);
+    return n;
+}
+
+long balancedBSTUnion(long n, long *keys, double *seconds) {
+    return runBSTUnion(n, keys, seconds, 1);
+}
+
+long balancedBSTUnionParallel(long n, long *keys, double *seconds) {
+    return runBSTUnion(n, keys, seconds, BENCHMARK_THREADS);
+}
+
+/*
+    # Description:
+        - Returns the largest height of an AVL tree with n nodes
+*/
+int getMaxAVLHeight(long n) {
+    // Fewest nodes of an AVL tree of height h and h + 1
+    long fewest = 1, next = 2;
+    int height = 0;
+
+    for(; next <= n; height++) {
+        long after = fewest + next + 1;
+        fewest = next;
+        next = after;
+    }
+
+    return height;
+}
+
+/*
+    # Description:
+        - Times the join or the union of a balanced BST with the first keys and an
+          unbalanced BST with the last BENCHMARK_UNBALANCED keys, as tall as its size
+
+        - Returns 0 if the result is taller than an AVL tree can be
+*/
+long runBSTMixedJoin(long n, long *keys, double *seconds, bool join) {
+    BST bst = newBalancedBST(compareKeys);
+    BST other = newBST(compareKeys);
+    for(long i = 0; i < n; i++) insertBST((i < n - BENCHMARK_UNBALANCED) ? bst : other, &keys[i]);
+
+    double start = now();
+    if(join) joinBST(bst, other);
+    else unionBST(bst, other, 1);
+    *seconds = now() - start;
+
+    bool balanced = getBSTHeight(getBSTRoot(bst)) <= getMaxAVLHeight(n);
+
+    destroyBST(other);
+    destroyBST(bst);
+    return (balanced) ? BENCHMARK_UNBALANCED : 0;
+}
+
+long balancedBSTJoinUnbalanced(long n, long *keys, double *seconds) {
+    return runBSTMixedJoin(n, keys, seconds, true);
+}
+
+long balancedBSTUnionUnbalanced(long n, long *keys, double *seconds) {
+    return runBSTMixedJoin(n, keys, seconds, false);
+}
+
+long balancedBSTDestroy(long n, long *keys, double *seconds) {
+    BST bst = newBenchmarkBST(n, keys, true);
+
+    double start = now();
+    destroyBST(bst);
+    *seconds = now() - start;
+
+    return n;
+}
+
+long bstBuildSorted(long n, long *keys, double *seconds) {
+    BSTElement *elements = (BSTElement *) malloc(n * sizeof(BSTElement));
+    for(long i = 0; i < n; i++) elements[i] = &keys[i];
+
+    double start = now();
+    BST bst = buildBSTFromSorted(compareKeys, elements, n);
+    *seconds = now() - start;
+
+    destroyBST(bst);
+    free(elements);
+    return n;
+}
+
+// --- CBST ---
+
+typedef struct {
+    CBST cbst;
+    long *lookups;
+    long n;
+    long found;
+}CBSTWORK;
+
+long cbstInsert(long n, long *keys, double *seconds) {
+    CBST cbst = newCBST(compareKeys);
+
+    double start = now();
+    for(long i = 0; i < n; i++) insertCBST(cbst, &keys[i]);
+    *seconds = now() - start;
+
+    destroyCBST(cbst);
+    return n;
+}
+
+void *findCBST(void *extra) {
+    CBSTWORK *work = (CBSTWORK *) extra;
+
+    for(long i = 0; i < work->n; i++) work->found += findCBSTElement(work->cbst, &work->lookups[i]) != NULL;
+
+    return NULL;
+}
+
+/*
+    # Description:
+        - Times BENCHMARK_THREADS threads looking up each of the n keys at the same time
+*/
+long cbstFindParallel(long n, long *keys, double *seconds) {
+    CBST cbst = newCBST(compareKeys);
+    for(long i = 0; i < n; i++) insertCBST(cbst, &keys[i]);
+
+    long *lookups = newKeys(n, RANDOM);
+    pthread_t threads[BENCHMARK_THREADS];
+    CBSTWORK work[BENCHMARK_THREADS];
+
+    double start = now();
+    for(int i = 0; i < BENCHMARK_THREADS; i++) {
+        work[i] = (CBSTWORK) {cbst, lookups, n, 0};
+        pthread_create(&threads[i], NULL, findCBST, &work[i]);
+    }
+    for(int i = 0; i < BENCHMARK_THREADS; i++) pthread_join(threads[i], NULL);
+    *seconds = now() - start;
+
+    for(int i = 0; i < BENCHMARK_THREADS; i++) benchmarkSink += work[i].found;
+
+    free(lookups);
+    destroyCBST(cbst);
+    return n * BENCHMARK_THREADS;
+}
+
+// --- PBST ---
+
+long pbstInsert(long n, long *keys, double *seconds) {
+    PBST pbst = newPBST(compareKeys);
+
+    double start = now();
+    for(long i = 0; i < n; i++) insertPBST(pbst, &keys[i]);
+    *seconds = now() - start;
+
+    destroyPBST(pbst);
+    return n;
+}
+
+/*
+    # Description:
+        - Times the insertion of the n keys taking a snapshot before each one,
+          so every insertion copies its path
+*/
+long pbstInsertSnapshot(long n, long *keys, double *seconds) {
+    PBST pbst = newPBST(compareKeys);
+    PBST snapshot = NULL;
+
+    double start = now();
+    for(long i = 0; i < n; i++) {
+        destroyPBST(snapshot);
+        snapshot = snapshotPBST(pbst);
+
+        insertPBST(pbst, &keys[i]);
+    }
+    *seconds = now() - start;
+
+    destroyPBST(snapshot);
+    destroyPBST(pbst);
+    return n;
+}
+
+// --- IBST ---
+
+long ibstInsert(long n, long *keys, double *seconds) {
+    IBST ibst = newIBST();
+
+    double start = now();
+    for(long i = 0; i < n; i++) insertIBST(ibst, keys[i], &keys[i]);
+    *seconds = now() - start;
+
+    destroyIBST(ibst);
+    return n;
+}
+
+/*
+    # Description:
+        - Same as balancedBSTFind, with the keys stored in the nodes of an IBST
+*/
+long ibstFind(long n, long *keys, double *seconds) {
+    IBST ibst = newIBST();
+    for(long i = 0; i < n; i++) insertIBST(ibst, keys[i], &keys[i]);
+
+    long *lookups = newKeys(n, RANDOM);
+    long found = 0;
+
+    double start = now();
+    for(long i = 0; i < n; i++) found += findIBSTElement(ibst, lookups[i]) != NULL;
+    *seconds = now() - start;
+
+    benchmarkSink = found;
+
+    free(lookups);
+    destroyIBST(ibst);
+    return n;
+}
+
+// --- Generic List and BST ---
+
+DEFINE_LIST(LongList, long)
+DEFINE_BST(LongBST, long, long, BST_COMPARE_NUMBERS)
+
+/*
+    # Description:
+        - Same as listTraverse, with the keys stored in the nodes of a LongList
+*/
+long genericListTraverse(long n, long *keys, double *seconds) {
+    LongList *list = newLongList();
+    for(long i = 0; i < n; i++) insertEndLongList(list, keys[i]);
+
+    long sum = 0;
+
+    double start = now();
+    for(LongListNode *node = list->head; node; node = node->next) sum += node->value;
+    *seconds = now() - start;
+
+    benchmarkSink = sum;
+
+    destroyLongList(list);
+    return n;
+}
+
+/*
+    # Description:
+        - Same as balancedBSTFind, with the keys stored in the nodes of a LongBST
+*/
+long genericBSTFind(long n, long *keys, double *seconds) {
+    LongBST *bst = newLongBST();
+    for(long i = 0; i < n; i++) insertLongBST(bst, keys[i], i);
+
+    long *lookups = newKeys(n, RANDOM);
+    long found = 0;
+
+    double start = now();
+    for(long i = 0; i < n; i++) found += findLongBST(bst, lookups[i]) != NULL;
+    *seconds = now() - start;
+
+    benchmarkSink = found;
+
+    free(lookups);
+    destroyLongBST(bst);
+    return n;
+}
+
+// --- BTree ---
+
+/*
+    # Description:
+        - Returns a new BTree with the n keys inserted in order
+*/
+BTree newBenchmarkBTree(long n, long *keys) {
+    BTree btree = newBTree(compareKeys);
+    for(long i = 0; i < n; i++) insertBTree(btree, &keys[i]);
+
+    return btree;
+}
+
+long btreeInsert(long n, long *keys, double *seconds) {
+    BTree btree = newBTree(compareKeys);
+
+    double start = now();
+    for(long i = 0; i < n; i++) insertBTree(btree, &keys[i]);
+    *seconds = now() - start;
+
+    destroyBTree(btree);
+    return n;
+}
+
+long btreeFind(long n, long *keys, double *seconds) {
+    BTree btree = newBenchmarkBTree(n, keys);
+    long *lookups = newKeys(n, RANDOM);
+    long found = 0;
+
+    double start = now();
+    for(long i = 0; i < n; i++) found += findBTreeElement(btree, &lookups[i]) != NULL;
+    *seconds = now() - start;
+
+    benchmarkSink = found;
+
+    free(lookups);
+    destroyBTree(btree);
+    return n;
+}
+
+long btreeInOrder(long n, long *keys, double *seconds) {
+    BTree btree = newBenchmarkBTree(n, keys);
+    long sum = 0;
+
+    double start = now();
+    inOrderBTreeTraversal(btree, visitBTreeElement, &sum);
+    *seconds = now() - start;
+
+    benchmarkSink = sum;
+
+    destroyBTree(btree);
+    return n;
+}
+
+BENCHMARK benchmarks[] = {
+    {"list_push", SEQUENTIAL, 0, listPush},
+    {"list_insert_end", SEQUENTIAL, 0, listInsertEnd},
+    {"list_pop", SEQUENTIAL, 0, listPop},
+    {"list_queue", SEQUENTIAL, 0, listQueue},
+    {"list_concat", SEQUENTIAL, 0, listConcat},
+    {"list_insert_position", RANDOM, 0, listInsertPosition},
+    {"list_remove_position", RANDOM, 0, listRemovePosition},
+    {"list_traverse", SEQUENTIAL, 0, listTraverse},
+    {"list_sort", RANDOM, 0, listSort},
+    {"list_sort", SORTED, 0, listSort},
+    {"list_destroy", SEQUENTIAL, 0, listDestroy},
+
+    {"ulist_insert_end", SEQUENTIAL, 0, ulistInsertEnd},
+    {"ulist_traverse", SEQUENTIAL, 0, ulistTraverse},
+
+    {"deque_insert_end", SEQUENTIAL, 0, dequeInsertEnd},
+    {"deque_queue", SEQUENTIAL, 0, dequeQueue},
+    {"deque_traverse", SEQUENTIAL, 0, dequeTraverse},
+
+    {"clist_producer_consumer", SEQUENTIAL, 0, clistProducerConsumer},
+
+    // Sorted input degenerates the plain BST into a list, O(n^2) to build
+    {"bst_insert", RANDOM, 0, bstInsert},
+    {"bst_insert", SORTED, 10000, bstInsert},
+    {"bst_find", RANDOM, 0, bstFind},
+    {"bst_find", SORTED, 10000, bstFind},
+    {"balanced_bst_insert", RANDOM, 0, balancedBSTInsert},
+    {"balanced_bst_insert", SORTED, 0, balancedBSTInsert},
+    {"balanced_bst_insert", REVERSED, 0, balancedBSTInsert},
+    {"balanced_bst_find", RANDOM, 0, balancedBSTFind},
+    {"balanced_bst_find", SORTED, 0, balancedBSTFind},
+    {"balanced_bst_find_batch", RANDOM, 0, balancedBSTFindBatch},
+    {"balanced_bst_find_frozen", RANDOM, 0, balancedBSTFindFrozen},
+    {"mapped_bst_find", RANDOM, 0, mappedBSTFind},
+    {"balanced_bst_inorder", RANDOM, 0, balancedBSTInOrder},
+    {"balanced_bst_reduce_parallel", RANDOM, 0, balancedBSTReduceParallel},
+    {"balanced_bst_union", RANDOM, 0, balancedBSTUnion},
+    {"balanced_bst_union_parallel", RANDOM, 0, balancedBSTUnionParallel},
+    {"balanced_bst_join_unbalanced", SORTED, 0, balancedBSTJoinUnbalanced},
+    {"balanced_bst_union_unbalanced", SORTED, 0, balancedBSTUnionUnbalanced},
+    {"balanced_bst_destroy", RANDOM, 0, balancedBSTDestroy},
+    {"bst_build_sorted", SORTED, 0, bstBuildSorted},
+
+    // Each insertion copies its path, the lookups run in BENCHMARK_THREADS threads
+    {"cbst_insert", RANDOM, 0, cbstInsert},
+    {"cbst_find_parallel", RANDOM, 0, cbstFindParallel},
+
+    {"pbst_insert", RANDOM, 0, pbstInsert},
+    {"pbst_insert_snapshot", RANDOM, 0, pbstInsertSnapshot},
+
+    {"ibst_insert", RANDOM, 0, ibstInsert},
+    {"ibst_find", RANDOM, 0, ibstFind},
+
+    {"generic_list_traverse", SEQUENTIAL, 0, genericListTraverse},
+    {"generic_bst_find", RANDOM, 0, genericBSTFind},
+
+    {"btree_insert", RANDOM, 0, btreeInsert},
+    {"btree_insert", SORTED, 0, btreeInsert},
+    {"btree_find", RANDOM, 0, btreeFind},
+    {"btree_inorder", RANDOM, 0, btreeInOrder},
+};
+
+/*
+    # Description:
+        - ErrorHandler of the benchmarks, prints message to stderr
+*/
+void printBenchmarkError(const char *message, void *extra) {
+    (void) extra;
+
+    fputs(message, stderr);
+}
+
+/*
+    # Input:
+        - benchmark: Benchmark to be run
+        - n: Number of elements
+    
+    # Description:
+        - Runs benchmark in a child process and prints its result
+*/
+void runBenchmark(BENCHMARK *benchmark, long n) {
+    fflush(stdout);
+
+    pid_t pid = fork();
+    if(pid < 0) {
+        fprintf(stderr, "ERROR: Could not create process -- runBenchmark --\n");
+        return;
+    }
+
+    if(pid > 0) {
+        waitpid(pid, NULL, 0);
+        return;
+    }
+
+    long *keys = newKeys(n, benchmark->pattern);
+    if(!keys) {
+        fprintf(stderr, "ERROR: Could not allocate memory for keys -- runBenchmark --\n");
+        exit(EXIT_FAILURE);
+    }
+
+    double seconds = 0;
+    long ops = benchmark->run(n, keys, &seconds);
+
+    // Only results go to stdout, so it can be parsed line by line
+    if(ops <= 0) {
+        fprintf(stderr, "ERROR: Benchmark %s could not run for n = %ld -- runBenchmark --\n", benchmark->name, n);
+        free(keys);
+        exit(EXIT_FAILURE);
+    }
+
+    struct rusage usage;
+    getrusage(RUSAGE_SELF, &usage);
+
+    printf("{\"benchmark\": \"%s\", \"pattern\": \"%s\", \"n\": %ld, \"ops\": %ld, \"ns_per_op\": %.2f, \"ops_per_sec\": %.1f, \"peak_rss_kb\": %ld}\n",
+           benchmark->name, patternNames[benchmark->pattern], n, ops, seconds * 1e9 / ops, ops / seconds, usage.ru_maxrss);
+
+    free(keys);
+    exit(EXIT_SUCCESS);
+}
+
+int main(int argc, char *argv[]) {
+    int maxExponent = (argc > 1) ? atoi(argv[1]) : 6;
+    const char *filter = (argc > 2) ? argv[2] : "";
+
+    setErrorHandler(printBenchmarkError, NULL);
+
+    if(maxExponent < 3 || maxExponent > 7) {
+        fprintf(stderr, "WARNING: max exponent must be inside [3, 7] -- main --\n");
+        return EXIT_FAILURE;
+    }
+
+    for(size_t i = 0; i < sizeof(benchmarks) / sizeof(benchmarks[0]); i++) {
+        if(!strstr(benchmarks[i].name, filter)) continue;
+
+        long n = 1000;
+        for(int exponent = 3; exponent <= maxExponent; exponent++, n *= 10) {
+            if(benchmarks[i].maxN && n > benchmarks[i].maxN) break;
+
+            runBenchmark(&benchmarks[i], n);
+        }
+    }
+
+    return EXIT_SUCCESS;
+}
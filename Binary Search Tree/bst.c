@@ -1,44 +1,135 @@
-#include <stdio.h>
+#include <pthread.h>
+#include <sched.h>
+#include <stdatomic.h>
 #include <stdlib.h>
+#include <string.h>
 
-#include "bst.h"
+#include "bst_inline.h"
+#include "../List/deque.h"
+#include "../Common/error.h"
 
-typedef struct bstnode {
-    int height;
-    struct bstnode *parent, *leftChild, *rightChild;
-    BSTElement element;
-} BSTNODE;
+// Number of lookups findBSTBatch keeps in flight, enough to overlap the cache misses of each level
+#define BST_BATCH_LOOKUPS 16
 
-typedef struct {
-    CompareElementsBST compare;
-    BSTNODE *root;
-}BSTTREE;
+// Smallest set operation, in nodes, that is split between threads
+#define BST_PARALLEL_MIN_SIZE 8192
 
-BST newBST(CompareElementsBST compare) {
-    if(!compare) {
-        printf("WARNING: Invalid parameter -- newBST --\n");
-        return NULL;
-    }
+// Subtrees with at most this many nodes are visited by a single thread in parallel traversals
+#define BST_PARALLEL_GRAIN 1024
+
+// The arrays of a frozen BST and the workers of a parallel traversal start at a cache line
+#define BST_CACHE_LINE 64
+
+// Set operations on taller subtrees run without recursion, an AVL tree never gets this tall
+#define BST_MAX_RECURSION_HEIGHT 128
 
+#if defined(__GNUC__)
+#define BST_PREFETCH(address) __builtin_prefetch(address)
+#else
+#define BST_PREFETCH(address) ((void) (address))
+#endif
+
+/*
+    # Input:
+        - compare: Function to compare BSTElement for new BST
+        - balanced: If true, the new BST is kept AVL balanced
+        - allocate: Function used to allocate memory for the nodes, can be NULL
+        - release: Function used to free memory allocated by allocate, can be NULL
+        - extra: Extra pointer given to allocate and release
+    
+    # Description:
+        - Returns a pointer to a new BST
+*/
+BSTTREE *newBSTTree(CompareElementsBST compare, bool balanced, AllocateMemory allocate, FreeMemory release, void *extra) {
     BSTTREE *bst = (BSTTREE *) malloc(sizeof(BSTTREE));
     if(!bst) {
-        printf("ERROR: Could not allocate memory for new BST -- newBST --\n");
+        reportError("ERROR: Could not allocate memory for new BST -- newBSTTree --\n");
+        return NULL;
+    }
+
+    bst->pool = newPool(sizeof(BSTNODE), allocate, release, extra);
+    if(!bst->pool) {
+        reportError("ERROR: Could not allocate memory for new BST -- newBSTTree --\n");
+        free(bst);
         return NULL;
     }
 
     bst->compare = compare;
+    bst->balanced = balanced;
     bst->root = NULL;
+    bst->frozen = NULL;
 
     return bst;
 }
 
+BST newBST(CompareElementsBST compare) {
+    if(PARAMETER_CHECK(!compare)) {
+        reportError("WARNING: Invalid parameter -- newBST --\n");
+        return NULL;
+    }
+
+    return newBSTTree(compare, false, NULL, NULL, NULL);
+}
+
+BST newBalancedBST(CompareElementsBST compare) {
+    if(PARAMETER_CHECK(!compare)) {
+        reportError("WARNING: Invalid parameter -- newBalancedBST --\n");
+        return NULL;
+    }
+
+    return newBSTTree(compare, true, NULL, NULL, NULL);
+}
+
+BST newBSTWithAllocator(CompareElementsBST compare, bool balanced, AllocateMemory allocate, FreeMemory release, void *extra) {
+    if(PARAMETER_CHECK(!compare || (!allocate != !release))) {
+        reportError("WARNING: Invalid parameters -- newBSTWithAllocator --\n");
+        return NULL;
+    }
+
+    return newBSTTree(compare, balanced, allocate, release, extra);
+}
+
+BST newBSTSharedPool(BST bst) {
+    if(PARAMETER_CHECK(!bst)) {
+        reportError("WARNING: Invalid parameter -- newBSTSharedPool --\n");
+        return NULL;
+    }
+
+    BSTTREE *other = (BSTTREE *) bst;
+
+    BSTTREE *tree = (BSTTREE *) malloc(sizeof(BSTTREE));
+    if(!tree) {
+        reportError("ERROR: Could not allocate memory for new BST -- newBSTSharedPool --\n");
+        return NULL;
+    }
+
+    tree->pool = sharePool(other->pool);
+    tree->compare = other->compare;
+    tree->balanced = other->balanced;
+    tree->root = NULL;
+    tree->frozen = NULL;
+
+    return tree;
+}
+
+bool isBSTBalanced(BST bst) {
+    if(PARAMETER_CHECK(!bst)) {
+        reportError("WARNING: Invalid parameter -- isBSTBalanced --\n");
+        return false;
+    }
+
+    BSTTREE *tree = (BSTTREE *) bst;
+
+    return tree->balanced;
+}
+
 bool isBSTEmpty(BSTNode root) {
     if(!root) return true;
 
     return getBSTHeight(root) == 0;
 }
 
-int getBSTHeight(BSTNode root) {
+int (getBSTHeight)(BSTNode root) {
     if(!root) return -1;
 
     BSTNODE *node = (BSTNODE *) root;
@@ -47,18 +138,22 @@ int getBSTHeight(BSTNode root) {
 }
 
 /*
+    # Input:
+        - tree: BST the node will belong to
+    
     # Description:
-        - Returns a pointer to a new empty BSTNode
+        - Returns a pointer to a new empty BSTNode allocated from the pool of tree
 */
-BSTNODE *newBSTNode() {
-    BSTNODE *node = (BSTNODE *) malloc(sizeof(BSTNODE));
+BSTNODE *newBSTNode(BSTTREE *tree) {
+    BSTNODE *node = (BSTNODE *) allocatePool(tree->pool);
     if(!node) {
-        printf("ERROR: Could not allocate memory for new BSTNode -- newBSTNode --\n");
+        reportError("ERROR: Could not allocate memory for new BSTNode -- newBSTNode --\n");
         return NULL;
     }
 
     node->element = NULL;
     node->height = 0;
+    node->size = 1;
     node->leftChild = NULL;
     node->parent = NULL;
     node->rightChild = NULL;
@@ -66,15 +161,272 @@ BSTNODE *newBSTNode() {
     return node;
 }
 
+/*
+    # Input:
+        - node: BSTNode
+    
+    # Description:
+        - Returns the number of nodes in the subtree rooted at node
+*/
+int getBSTNodeSize(BSTNODE *node) {
+    return (node) ? node->size : 0;
+}
+
+/*
+    # Input:
+        - node: BSTNode
+    
+    # Description:
+        - Recalculates the height and subtree size of node from its children
+*/
+void updateBSTNode(BSTNODE *node) {
+    int leftHeight = getBSTHeightInline(node->leftChild) + 1;
+    int rightHeight = getBSTHeightInline(node->rightChild) + 1;
+
+    node->height = (leftHeight > rightHeight) ? leftHeight : rightHeight;
+    node->size = getBSTNodeSize(node->leftChild) + getBSTNodeSize(node->rightChild) + 1;
+}
+
 void recalculateHeight(BSTNODE *root) {
-    if(!root) return;
+    // Unbalanced BSTs can be as tall as their size, the path is walked without recursion
+    for(; root; root = root->parent) updateBSTNode(root);
+}
+
+/*
+    # Input:
+        - tree: BST
+        - parent: Parent of oldChild, NULL if oldChild is the root of tree
+        - oldChild: Child of parent to be replaced
+        - newChild: Node that takes the place of oldChild, can be NULL
+    
+    # Description:
+        - Links newChild to parent in the position occupied by oldChild
+*/
+void replaceBSTChild(BSTTREE *tree, BSTNODE *parent, BSTNODE *oldChild, BSTNODE *newChild) {
+    if(!parent) tree->root = newChild;
+    else if(parent->leftChild == oldChild) parent->leftChild = newChild;
+    else parent->rightChild = newChild;
+
+    if(newChild) newChild->parent = parent;
+}
+
+/*
+    # Input:
+        - tree: BST
+        - node: Root of the subtree to be rotated, must have a right child
+    
+    # Description:
+        - Rotates the subtree rooted at node to the left and returns its new root
+*/
+BSTNODE *rotateBSTLeft(BSTTREE *tree, BSTNODE *node) {
+    BSTNODE *pivot = node->rightChild;
+
+    node->rightChild = pivot->leftChild;
+    if(pivot->leftChild) pivot->leftChild->parent = node;
+
+    replaceBSTChild(tree, node->parent, node, pivot);
+
+    pivot->leftChild = node;
+    node->parent = pivot;
+
+    updateBSTNode(node);
+    updateBSTNode(pivot);
+
+    return pivot;
+}
+
+/*
+    # Input:
+        - tree: BST
+        - node: Root of the subtree to be rotated, must have a left child
+    
+    # Description:
+        - Rotates the subtree rooted at node to the right and returns its new root
+*/
+BSTNODE *rotateBSTRight(BSTTREE *tree, BSTNODE *node) {
+    BSTNODE *pivot = node->leftChild;
+
+    node->leftChild = pivot->rightChild;
+    if(pivot->rightChild) pivot->rightChild->parent = node;
+
+    replaceBSTChild(tree, node->parent, node, pivot);
+
+    pivot->rightChild = node;
+    node->parent = pivot;
+
+    updateBSTNode(node);
+    updateBSTNode(pivot);
+
+    return pivot;
+}
+
+/*
+    # Input:
+        - node: BSTNode
+    
+    # Description:
+        - Returns the height of the left subtree of node minus
+          the height of its right subtree
+*/
+int getBSTNodeBalance(BSTNODE *node) {
+    return getBSTHeightInline(node->leftChild) - getBSTHeightInline(node->rightChild);
+}
+
+/*
+    # Input:
+        - tree: BST
+        - node: Lowest node whose subtree was changed
+    
+    # Description:
+        - Walks from node up to the root of tree updating heights and sizes and,
+          if tree is balanced, rotating every node that violates the
+          AVL property
+*/
+void rebalanceBST(BSTTREE *tree, BSTNODE *node) {
+    if(!tree->balanced) {
+        recalculateHeight(node);
+        return;
+    }
+
+    while(node) {
+        updateBSTNode(node);
+
+        int balance = getBSTNodeBalance(node);
+        if(balance > 1) {
+            if(getBSTNodeBalance(node->leftChild) < 0) rotateBSTLeft(tree, node->leftChild);
+            node = rotateBSTRight(tree, node);
+        }
+        else if(balance < -1) {
+            if(getBSTNodeBalance(node->rightChild) > 0) rotateBSTRight(tree, node->rightChild);
+            node = rotateBSTLeft(tree, node);
+        }
+
+        node = node->parent;
+    }
+}
+
+/*
+    - Source of the elements used by buildBSTNodes, elements are taken
+      from the array elements or, if it is NULL, from the nodes of list
+*/
+typedef struct {
+    BSTElement *elements;
+    int next;
+    List list;
+    ListNode listNode;
+    BSTElement previous;
+    bool sorted;
+}BSTBUILDER;
+
+/*
+    # Input:
+        - tree: BST being built
+        - builder: Source of the elements
+    
+    # Description:
+        - Returns the next element of builder and checks it is not
+          smaller than the previous one
+*/
+BSTElement nextBSTBuilderElement(BSTTREE *tree, BSTBUILDER *builder) {
+    BSTElement element;
+
+    if(builder->elements) element = builder->elements[builder->next++];
+    else {
+        element = getListNodeElement(builder->list, builder->listNode);
+        builder->listNode = getNextListNode(builder->list, builder->listNode);
+    }
+
+    if(!element || (builder->previous && tree->compare(builder->previous, element) > 0)) builder->sorted = false;
+    builder->previous = element;
+
+    return element;
+}
+
+/*
+    # Input:
+        - tree: BST being built
+        - builder: Source of the elements
+        - count: Number of elements in the subtree
     
-    int leftHeight = getBSTHeight(root->leftChild) + 1;
-    int rightHeight = getBSTHeight(root->rightChild) + 1;
+    # Description:
+        - Builds a height-balanced subtree with the next count elements
+          of builder and returns its root
 
-    root->height = (leftHeight > rightHeight) ? leftHeight : rightHeight;
+        - Nodes are created in-order, so they are laid out in sorted order
+          in the pool of tree
+*/
+BSTNODE *buildBSTNodes(BSTTREE *tree, BSTBUILDER *builder, int count) {
+    if(count <= 0) return NULL;
+
+    BSTNODE *left = buildBSTNodes(tree, builder, (count - 1) / 2);
+
+    BSTNODE *node = newBSTNode(tree);
+    node->element = nextBSTBuilderElement(tree, builder);
+
+    node->leftChild = left;
+    if(left) left->parent = node;
+
+    node->rightChild = buildBSTNodes(tree, builder, count / 2);
+    if(node->rightChild) node->rightChild->parent = node;
+
+    updateBSTNode(node);
+
+    return node;
+}
+
+/*
+    # Input:
+        - compare: Function to compare BSTElement for new BST
+        - builder: Source of the elements
+        - count: Number of elements
     
-    recalculateHeight(root->parent);
+    # Description:
+        - Returns a new balanced BST with the count elements of builder
+
+        - If the elements are not sorted, returns NULL
+*/
+BST buildBST(CompareElementsBST compare, BSTBUILDER *builder, int count) {
+    BSTTREE *tree = newBSTTree(compare, true, NULL, NULL, NULL);
+    if(!tree) return NULL;
+
+    // All nodes are carved from one block
+    if(!reservePool(tree->pool, count)) {
+        reportError("ERROR: Could not allocate memory for BST nodes -- buildBST --\n");
+        destroyBST(tree);
+        return NULL;
+    }
+
+    tree->root = buildBSTNodes(tree, builder, count);
+
+    if(!builder->sorted) {
+        reportError("WARNING: Elements are not sorted -- buildBST --\n");
+        destroyBST(tree);
+        return NULL;
+    }
+
+    return tree;
+}
+
+BST buildBSTFromSorted(CompareElementsBST compare, BSTElement *elements, int n) {
+    if(PARAMETER_CHECK(!compare || (!elements && n > 0) || n < 0)) {
+        reportError("WARNING: Invalid parameters -- buildBSTFromSorted --\n");
+        return NULL;
+    }
+
+    BSTBUILDER builder = {elements, 0, NULL, NULL, NULL, true};
+
+    return buildBST(compare, &builder, n);
+}
+
+BST buildBSTFromList(CompareElementsBST compare, List list) {
+    if(PARAMETER_CHECK(!compare || !list)) {
+        reportError("WARNING: Invalid parameters -- buildBSTFromList --\n");
+        return NULL;
+    }
+
+    BSTBUILDER builder = {NULL, 0, list, getFirstListNode(list), NULL, true};
+
+    return buildBST(compare, &builder, getListSize(list));
 }
 
 /*
@@ -89,42 +441,45 @@ void recalculateHeight(BSTNODE *root) {
         - The insertion follows the insertion rules of a BST
 */
 void insertBSTNode(CompareElementsBST compare, BSTNODE *currentNode, BSTNODE *newNode) {
-    if(compare(newNode->element, currentNode->element) > 1) {
-        if(currentNode->rightChild) insertBSTNode(compare, currentNode->rightChild, newNode);
-        else {
-            newNode->parent = currentNode;
-            currentNode->rightChild = newNode;
-        }
-    }
-    else {
-        if(currentNode->leftChild) insertBSTNode(compare, currentNode->leftChild, newNode);
-        else {
+    // Unbalanced BSTs can be as tall as their size, the descent is a loop
+    while(true) {
+        BSTNODE **child = (compare(newNode->element, currentNode->element) > 0) ? &currentNode->rightChild : &currentNode->leftChild;
+
+        if(!*child) {
             newNode->parent = currentNode;
-            currentNode->leftChild = newNode;
+            *child = newNode;
+            return;
         }
+
+        currentNode = *child;
     }
 }
 
 BSTNode insertBST(BST bst, BSTElement element) {
-    if(!bst || !element) {
-        printf("WARNING: Invalid parameters -- insertBST --\n");
+    if(PARAMETER_CHECK(!bst || !element)) {
+        reportError("WARNING: Invalid parameters -- insertBST --\n");
         return NULL;
     }
 
     BSTTREE *tree = (BSTTREE *) bst;
 
-    BSTNODE *node = newBSTNode();
+    if(tree->frozen) {
+        reportError("WARNING: BST is frozen -- insertBST --\n");
+        return NULL;
+    }
+
+    BSTNODE *node = newBSTNode(tree);
     if(!node) {
-        printf("WARNING: Could not insert element in BST -- insertBST --\n");
+        reportError("WARNING: Could not insert element in BST -- insertBST --\n");
         return NULL;
     }
 
     node->element = element;
 
     if(!tree->root) tree->root = node;
-    else insertBSTNode(tree->compare, (BSTNODE *) getBSTRoot(bst), node);
+    else insertBSTNode(tree->compare, tree->root, node);
 
-    recalculateHeight(node);
+    rebalanceBST(tree, node->parent);
 
     return node;
 }
@@ -147,48 +502,118 @@ BSTNODE *getSmallestNode(BSTNODE *root) {
 }
 
 BSTElement removeBST(BST bst, BSTNode node) {
-    if(!bst || !node) {
-        printf("WARNING: Invalid parameters -- removeBST --\n");
+    if(PARAMETER_CHECK(!bst || !node)) {
+        reportError("WARNING: Invalid parameters -- removeBST --\n");
         return NULL;
     }
 
     BSTTREE *tree = (BSTTREE *) bst;
+
+    if(tree->frozen) {
+        reportError("WARNING: BST is frozen -- removeBST --\n");
+        return NULL;
+    }
+
     BSTNODE *nd = (BSTNODE *) node;
-    BSTElement *element = nd->element;
+    BSTElement element = nd->element;
+
+    // Lowest node whose subtree changes
+    BSTNODE *changed;
 
     if(nd->leftChild && nd->rightChild) {
-        node = getSmallestNode(nd->rightChild);
-        nd->element = getBSTNodeElement(node);
+        // Relink the in-order successor in place of nd, so handles to it stay valid
+        BSTNODE *successor = getSmallestNode(nd->rightChild);
 
-        nd = (BSTNODE *) node;
-    }
+        if(successor->parent != nd) {
+            changed = successor->parent;
 
-    bool parent = nd->parent;
-    bool isNdLeftChild = (parent) ? (tree->compare(nd->parent->element, nd->element) <= 0) : false;
-    if(!nd->leftChild && !nd->rightChild) {
-        if(parent && isNdLeftChild) nd->parent->leftChild = NULL;
-        else if(parent) nd->parent->rightChild = NULL;
-    }
-    else if(!nd->leftChild || !nd->rightChild) {
-        BSTNODE *nextRoot = (nd->leftChild) ? nd->leftChild : nd->rightChild;
+            replaceBSTChild(tree, successor->parent, successor, successor->rightChild);
 
-        if(parent && isNdLeftChild) nd->parent->leftChild = nextRoot;
-        else if(parent) nd->parent->rightChild = nextRoot;
+            successor->rightChild = nd->rightChild;
+            successor->rightChild->parent = successor;
+        }
+        else changed = successor;
+
+        replaceBSTChild(tree, nd->parent, nd, successor);
+
+        successor->leftChild = nd->leftChild;
+        successor->leftChild->parent = successor;
+    }
+    else {
+        changed = nd->parent;
 
-        nextRoot->parent = nd->parent;
+        replaceBSTChild(tree, nd->parent, nd, (nd->leftChild) ? nd->leftChild : nd->rightChild);
     }
 
-    recalculateHeight(nd->parent);
+    rebalanceBST(tree, changed);
 
-    free(node);
+    freePool(tree->pool, nd);
     node = NULL;
 
     return element;
 }
 
-BSTNode getBSTRoot(BST bst) {
-    if(!bst) {
-        printf("WARNING: Invalid parameter -- getBSTRoot --\n");
+int (getBSTSize)(BST bst) {
+    if(PARAMETER_CHECK(!bst)) {
+        reportError("WARNING: Invalid parameter -- getBSTSize --\n");
+        return 0;
+    }
+
+    BSTTREE *tree = (BSTTREE *) bst;
+
+    return getBSTNodeSize(tree->root);
+}
+
+BSTNode selectBST(BST bst, int k) {
+    if(PARAMETER_CHECK(!bst)) {
+        reportError("WARNING: Invalid parameter -- selectBST --\n");
+        return NULL;
+    }
+
+    BSTTREE *tree = (BSTTREE *) bst;
+    BSTNODE *node = tree->root;
+
+    if(k < 0 || k >= getBSTNodeSize(node)) return NULL;
+
+    while(node) {
+        int leftSize = getBSTNodeSize(node->leftChild);
+
+        if(k == leftSize) break;
+
+        if(k < leftSize) node = node->leftChild;
+        else {
+            k -= leftSize + 1;
+            node = node->rightChild;
+        }
+    }
+
+    return node;
+}
+
+int rankBST(BST bst, BSTElement element) {
+    if(PARAMETER_CHECK(!bst || !element)) {
+        reportError("WARNING: Invalid parameters -- rankBST --\n");
+        return 0;
+    }
+
+    BSTTREE *tree = (BSTTREE *) bst;
+    BSTNODE *node = tree->root;
+    int rank = 0;
+
+    while(node) {
+        if(tree->compare(node->element, element) < 0) {
+            rank += getBSTNodeSize(node->leftChild) + 1;
+            node = node->rightChild;
+        }
+        else node = node->leftChild;
+    }
+
+    return rank;
+}
+
+BSTNode (getBSTRoot)(BST bst) {
+    if(PARAMETER_CHECK(!bst)) {
+        reportError("WARNING: Invalid parameter -- getBSTRoot --\n");
         return NULL;
     }
 
@@ -197,9 +622,9 @@ BSTNode getBSTRoot(BST bst) {
     return tree->root;
 }
 
-BSTNode getBSTNodeLeftNode(BSTNode node) {
-    if(!node) {
-        printf("WARNING: Invalid parameter -- getBSTNodeLeftNode --\n");
+BSTNode (getBSTNodeLeftNode)(BSTNode node) {
+    if(PARAMETER_CHECK(!node)) {
+        reportError("WARNING: Invalid parameter -- getBSTNodeLeftNode --\n");
         return NULL;
     }
 
@@ -208,9 +633,9 @@ BSTNode getBSTNodeLeftNode(BSTNode node) {
     return nd->leftChild;
 }
 
-BSTNode getBSTNodeRightNode(BSTNode node) {
-    if(!node) {
-        printf("WARNING: Invalid parameter -- getBSTNodeRightNode --\n");
+BSTNode (getBSTNodeRightNode)(BSTNode node) {
+    if(PARAMETER_CHECK(!node)) {
+        reportError("WARNING: Invalid parameter -- getBSTNodeRightNode --\n");
         return NULL;
     }
 
@@ -219,9 +644,9 @@ BSTNode getBSTNodeRightNode(BSTNode node) {
     return nd->rightChild;
 }
 
-BSTNode getBSTNodeParentNode(BSTNode node) {
-    if(!node) {
-        printf("WARNING: Invalid parameter -- getBSTNodeParentNode --\n");
+BSTNode (getBSTNodeParentNode)(BSTNode node) {
+    if(PARAMETER_CHECK(!node)) {
+        reportError("WARNING: Invalid parameter -- getBSTNodeParentNode --\n");
         return NULL;
     }
 
@@ -230,9 +655,9 @@ BSTNode getBSTNodeParentNode(BSTNode node) {
     return nd->parent;
 }
 
-BSTElement getBSTNodeElement(BSTNode node) {
-    if(!node) {
-        printf("WARNING: Invalid parameter -- getBSTNodeElement --\n");
+BSTElement (getBSTNodeElement)(BSTNode node) {
+    if(PARAMETER_CHECK(!node)) {
+        reportError("WARNING: Invalid parameter -- getBSTNodeElement --\n");
         return NULL;
     }
 
@@ -251,130 +676,1584 @@ BSTElement getBSTNodeElement(BSTNode node) {
         - Returns the node that stores element, if node doesn't exists, returns NULL
 */
 BSTNODE *findBST(CompareElementsBST compare, BSTNODE *node, BSTElement element) {
-    if(!node) return NULL;
+    while(node) {
+        int cmp = compare(node->element, element);
 
-    int cmp = compare(node->element, element);
+        if(cmp == 0) return node;
+        node = (cmp > 0) ? node->leftChild : node->rightChild;
+    }
 
-    if(cmp == 0) return node;
-    if(cmp == 1) return getBSTNodeLeftNode(node);
-    return getBSTNodeRightNode(node);
+    return NULL;
 }
 
-BSTNode findBSTNodeElement(BST bst, BSTElement element) {
-    if(!bst || !element) {
-        printf("WARNING: Invalid parameters -- findBSTNodeElement --\n");
-        return NULL;
-    }
+/*
+    # Input:
+        - frozen: Layout being filled
+        - slot: Slot of the root of the subtree to be filled
+        - node: Next node in-order, it is advanced past the nodes placed
+    
+    # Description:
+        - Places the nodes from *node on, in-order, in the slots of the
+          subtree rooted at slot
+*/
+void fillFrozenBST(BSTFROZEN *frozen, size_t slot, BSTNODE **node) {
+    if(slot > (size_t) frozen->size) return;
 
-    BSTTREE *tree = (BSTTREE *) bst;
-    BSTNODE *node = (BSTNODE *) getBSTRoot(bst);
+    fillFrozenBST(frozen, 2 * slot, node);
+
+    frozen->elements[slot] = (*node)->element;
+    frozen->nodes[slot] = *node;
+    *node = (BSTNODE *) getBSTNodeSuccessor(*node);
 
-    return findBST(tree->compare, node, element);
+    fillFrozenBST(frozen, 2 * slot + 1, node);
 }
 
-void inOrder(BST bst, BSTNODE *node, VisitBSTNode visit, void *extra) {
-    if(!node) return;
+/*
+    # Input:
+        - count: Number of pointers
+    
+    # Description:
+        - Returns an array of count pointers that starts at a cache line
+*/
+void *newFrozenBSTArray(size_t count) {
+    size_t size = (count * sizeof(void *) + BST_CACHE_LINE - 1) / BST_CACHE_LINE * BST_CACHE_LINE;
 
-    inOrder(bst, getBSTNodeLeftNode(node), visit, extra);
-    if(visit) visit(bst, node, extra);
-    inOrder(bst, getBSTNodeRightNode(node), visit, extra);
+    return aligned_alloc(BST_CACHE_LINE, size);
 }
 
-void inOrderBSTTraversal(BST bst, VisitBSTNode visit, void *extra) {
-    if(!bst) {
-        printf("WARNING: Invalid parameter -- inOrderBSTTraversal --\n");
-        return;
+bool freezeBST(BST bst) {
+    if(PARAMETER_CHECK(!bst)) {
+        reportError("WARNING: Invalid parameter -- freezeBST --\n");
+        return false;
     }
 
-    inOrder(bst, getBSTRoot(bst), visit, extra);
+    BSTTREE *tree = (BSTTREE *) bst;
+    if(tree->frozen) return true;
+
+    BSTFROZEN *frozen = (BSTFROZEN *) malloc(sizeof(BSTFROZEN));
+    if(!frozen) {
+        reportError("ERROR: Could not allocate memory for frozen BST -- freezeBST --\n");
+        return false;
+    }
+
+    frozen->size = getBSTNodeSize(tree->root);
+    frozen->elements = (BSTElement *) newFrozenBSTArray(frozen->size + 1);
+    frozen->nodes = (BSTNODE **) newFrozenBSTArray(frozen->size + 1);
+
+    if(!frozen->elements || !frozen->nodes) {
+        reportError("ERROR: Could not allocate memory for frozen BST -- freezeBST --\n");
+        free(frozen->elements);
+        free(frozen->nodes);
+        free(frozen);
+        return false;
+    }
+
+    // Slot 0 is the result of searches that find no bound
+    frozen->elements[0] = NULL;
+    frozen->nodes[0] = NULL;
+
+    if(tree->root) {
+        BSTNODE *node = getSmallestNode(tree->root);
+        fillFrozenBST(frozen, 1, &node);
+    }
+
+    tree->frozen = frozen;
+
+    return true;
+}
+
+void thawBST(BST bst) {
+    if(PARAMETER_CHECK(!bst)) {
+        reportError("WARNING: Invalid parameter -- thawBST --\n");
+        return;
+    }
+
+    BSTTREE *tree = (BSTTREE *) bst;
+    if(!tree->frozen) return;
+
+    free(tree->frozen->elements);
+    free(tree->frozen->nodes);
+    free(tree->frozen);
+
+    tree->frozen = NULL;
+}
+
+bool isBSTFrozen(BST bst) {
+    if(PARAMETER_CHECK(!bst)) {
+        reportError("WARNING: Invalid parameter -- isBSTFrozen --\n");
+        return false;
+    }
+
+    BSTTREE *tree = (BSTTREE *) bst;
+
+    return tree->frozen != NULL;
+}
+
+/*
+    # Input:
+        - tree: Frozen BST
+        - element: Element to be compared
+        - strict: If true, the bound is the smallest element > element
+    
+    # Description:
+        - Returns the slot of the smallest element >= element (> if strict)
+          in the layout of tree, or 0 if there is none
+
+        - The next slot is computed from each comparison instead of branching on it.
+          The slots 4 levels below are prefetched, and the elements of the children
+          of a slot are prefetched while its element is compared
+*/
+size_t findFrozenBSTSlot(BSTTREE *tree, BSTElement element, bool strict) {
+    BSTElement *elements = tree->frozen->elements;
+    size_t size = tree->frozen->size;
+    size_t slot = 1;
+
+    while(slot <= size) {
+        if(16 * slot <= size) BST_PREFETCH(&elements[16 * slot]);
+
+        if(2 * slot + 1 <= size) {
+            BST_PREFETCH(elements[2 * slot]);
+            BST_PREFETCH(elements[2 * slot + 1]);
+        }
+
+        int cmp = tree->compare(elements[slot], element);
+        slot = 2 * slot + (cmp < 0 || (strict && cmp == 0));
+    }
+
+    // The bound is where the descent last went left, undo the right turns taken after it
+    while(slot & 1) slot >>= 1;
+
+    return slot >> 1;
+}
+
+BSTNode findBSTNodeElement(BST bst, BSTElement element) {
+    if(PARAMETER_CHECK(!bst || !element)) {
+        reportError("WARNING: Invalid parameters -- findBSTNodeElement --\n");
+        return NULL;
+    }
+
+    BSTTREE *tree = (BSTTREE *) bst;
+
+    if(tree->frozen) {
+        size_t slot = findFrozenBSTSlot(tree, element, false);
+
+        return (slot && tree->compare(tree->frozen->elements[slot], element) == 0) ? tree->frozen->nodes[slot] : NULL;
+    }
+
+    return findBST(tree->compare, tree->root, element);
+}
+
+/*
+    - State of a lookup of findBSTBatch, each step of a lookup waits for a load
+      started by its previous step
+*/
+typedef struct {
+    int index;
+    BSTNODE *node;
+    bool elementLoaded;
+}BSTLOOKUP;
+
+/*
+    # Input:
+        - tree: BST
+        - lookup: Lookup to be started
+        - index: Position of the searched element in the batch
+
+    # Description:
+        - Starts lookup at the root of tree
+*/
+void startBSTLookup(BSTTREE *tree, BSTLOOKUP *lookup, int index) {
+    lookup->index = index;
+    lookup->node = tree->root;
+    lookup->elementLoaded = false;
+
+    if(lookup->node) BST_PREFETCH(lookup->node);
+}
+
+int findBSTBatch(BST bst, BSTElement *elements, int n, BSTNode *nodes) {
+    if(PARAMETER_CHECK(!bst || !elements || !nodes || n < 0)) {
+        reportError("WARNING: Invalid parameters -- findBSTBatch --\n");
+        return 0;
+    }
+
+    BSTTREE *tree = (BSTTREE *) bst;
+    BSTLOOKUP lookups[BST_BATCH_LOOKUPS];
+
+    int active = (n < BST_BATCH_LOOKUPS) ? n : BST_BATCH_LOOKUPS;
+    int next = active;
+    int found = 0;
+
+    for(int i = 0; i < active; i++) startBSTLookup(tree, &lookups[i], i);
+
+    // Each pass advances every lookup one step, by the time a lookup is visited again
+    // the node or element it prefetched has had the other lookups' steps to arrive
+    while(active) {
+        for(int i = 0; i < active; i++) {
+            BSTLOOKUP *lookup = &lookups[i];
+            BSTNODE *node = lookup->node;
+
+            if(node && !lookup->elementLoaded) {
+                BST_PREFETCH(node->element);
+                lookup->elementLoaded = true;
+                continue;
+            }
+
+            int cmp = (node) ? tree->compare(node->element, elements[lookup->index]) : 0;
+
+            if(cmp != 0) {
+                lookup->node = (cmp > 0) ? node->leftChild : node->rightChild;
+                lookup->elementLoaded = false;
+
+                if(lookup->node) BST_PREFETCH(lookup->node);
+                continue;
+            }
+
+            // The lookup is done, its place is taken by the next element or by the last lookup
+            nodes[lookup->index] = node;
+            if(node) found++;
+
+            if(next < n) startBSTLookup(tree, lookup, next++);
+            else lookups[i--] = lookups[--active];
+        }
+    }
+
+    return found;
+}
+
+/*
+    # Input:
+        - tree: BST
+        - element: Element to be compared
+        - strict: If true, equal elements are skipped
+    
+    # Description:
+        - Returns the node with the smallest element that is >= element,
+          or > element if strict is true
+
+        - If there is no such node, returns NULL
+*/
+BSTNODE *findBSTBound(BSTTREE *tree, BSTElement element, bool strict) {
+    if(tree->frozen) return tree->frozen->nodes[findFrozenBSTSlot(tree, element, strict)];
+
+    BSTNODE *bound = NULL;
+    BSTNODE *node = tree->root;
+
+    while(node) {
+        int cmp = tree->compare(node->element, element);
+
+        if(cmp > 0 || (cmp == 0 && !strict)) {
+            bound = node;
+            node = node->leftChild;
+        }
+        else node = node->rightChild;
+    }
+
+    return bound;
+}
+
+BSTNode lowerBoundBST(BST bst, BSTElement element) {
+    if(PARAMETER_CHECK(!bst || !element)) {
+        reportError("WARNING: Invalid parameters -- lowerBoundBST --\n");
+        return NULL;
+    }
+
+    return findBSTBound((BSTTREE *) bst, element, false);
+}
+
+BSTNode upperBoundBST(BST bst, BSTElement element) {
+    if(PARAMETER_CHECK(!bst || !element)) {
+        reportError("WARNING: Invalid parameters -- upperBoundBST --\n");
+        return NULL;
+    }
+
+    return findBSTBound((BSTTREE *) bst, element, true);
+}
+
+BSTNode getBSTNodeSuccessor(BSTNode node) {
+    if(PARAMETER_CHECK(!node)) {
+        reportError("WARNING: Invalid parameter -- getBSTNodeSuccessor --\n");
+        return NULL;
+    }
+
+    BSTNODE *nd = (BSTNODE *) node;
+
+    if(nd->rightChild) return getSmallestNode(nd->rightChild);
+
+    while(nd->parent && nd->parent->rightChild == nd) nd = nd->parent;
+
+    return nd->parent;
+}
+
+BSTNode getBSTNodePredecessor(BSTNode node) {
+    if(PARAMETER_CHECK(!node)) {
+        reportError("WARNING: Invalid parameter -- getBSTNodePredecessor --\n");
+        return NULL;
+    }
+
+    BSTNODE *nd = (BSTNODE *) node;
+
+    if(nd->leftChild) {
+        for(nd = nd->leftChild; nd->rightChild; nd = nd->rightChild);
+        return nd;
+    }
+
+    while(nd->parent && nd->parent->leftChild == nd) nd = nd->parent;
+
+    return nd->parent;
+}
+
+void rangeBST(BST bst, BSTElement lo, BSTElement hi, VisitBSTNode visit, void *extra) {
+    if(PARAMETER_CHECK(!bst || !lo || !hi)) {
+        reportError("WARNING: Invalid parameters -- rangeBST --\n");
+        return;
+    }
+
+    BSTTREE *tree = (BSTTREE *) bst;
+
+    for(BSTNODE *node = findBSTBound(tree, lo, false); node; node = getBSTNodeSuccessor(node)) {
+        if(tree->compare(node->element, hi) >= 0) return;
+        if(visit && visit(bst, node, extra)) return;
+    }
+}
+
+/*
+    # Input:
+        - node: BSTNode
+    
+    # Description:
+        - Returns the node visited after node in a pre-order traversal,
+          or NULL if node is the last one
+*/
+BSTNODE *getBSTPreOrderNext(BSTNODE *node) {
+    if(node->leftChild) return node->leftChild;
+    if(node->rightChild) return node->rightChild;
+
+    // Climb until an ancestor has a right subtree that was not visited yet
+    while(node->parent && (node->parent->rightChild == node || !node->parent->rightChild)) node = node->parent;
+
+    return (node->parent) ? node->parent->rightChild : NULL;
+}
+
+/*
+    # Input:
+        - root: Root of a subtree
+    
+    # Description:
+        - Returns the first node visited in a post-order traversal of
+          the subtree rooted at root
+*/
+BSTNODE *getBSTPostOrderFirst(BSTNODE *root) {
+    while(root->leftChild || root->rightChild) root = (root->leftChild) ? root->leftChild : root->rightChild;
+
+    return root;
 }
 
-void preOrder(BST bst, BSTNODE *node, VisitBSTNode visit, void *extra) {
-    if(!node) return;
+/*
+    # Input:
+        - node: BSTNode
+    
+    # Description:
+        - Returns the node visited after node in a post-order traversal,
+          or NULL if node is the last one
+*/
+BSTNODE *getBSTPostOrderNext(BSTNODE *node) {
+    BSTNODE *parent = node->parent;
+
+    if(parent && parent->leftChild == node && parent->rightChild) return getBSTPostOrderFirst(parent->rightChild);
+
+    return parent;
+}
+
+void inOrderBSTTraversal(BST bst, VisitBSTNode visit, void *extra) {
+    if(PARAMETER_CHECK(!bst)) {
+        reportError("WARNING: Invalid parameter -- inOrderBSTTraversal --\n");
+        return;
+    }
+
+    BSTTREE *tree = (BSTTREE *) bst;
+    if(!tree->root || !visit) return;
+
+    for(BSTNODE *node = getSmallestNode(tree->root); node; node = getBSTNodeSuccessor(node)) {
+        if(visit(bst, node, extra)) return;
+    }
+}
+
+void preOrderBSTTraversal(BST bst, VisitBSTNode visit, void *extra) {
+    if(PARAMETER_CHECK(!bst)) {
+        reportError("WARNING: Invalid parameter -- preOrderBSTTraversal --\n");
+        return;
+    }
+
+    BSTTREE *tree = (BSTTREE *) bst;
+    if(!visit) return;
+
+    for(BSTNODE *node = tree->root; node; node = getBSTPreOrderNext(node)) {
+        if(visit(bst, node, extra)) return;
+    }
+}
+
+void postOrderBSTTraversal(BST bst, VisitBSTNode visit, void *extra) {
+    if(PARAMETER_CHECK(!bst)) {
+        reportError("WARNING: Invalid parameter -- postOrderBSTTraversal --\n");
+        return;
+    }
+
+    BSTTREE *tree = (BSTTREE *) bst;
+    if(!tree->root || !visit) return;
+
+    for(BSTNODE *node = getBSTPostOrderFirst(tree->root); node; node = getBSTPostOrderNext(node)) {
+        if(visit(bst, node, extra)) return;
+    }
+}
+
+typedef struct bstparallel BSTPARALLEL;
+
+/*
+    - Thread of a parallel traversal, its deque holds the roots of the subtrees
+      it has still to visit
+
+    - Each worker takes its own cache lines, so the lock of a worker is not
+      written by the threads that steal from its neighbours
+*/
+typedef struct {
+    _Alignas(BST_CACHE_LINE) BSTPARALLEL *run;
+    int index;
+    Deque tasks;
+    pthread_mutex_t lock;
+    void *accumulator;
+}BSTWORKER;
+
+/*
+    - State shared by the threads of a parallel traversal, either visit or reduce is used
+*/
+struct bstparallel {
+    BST bst;
+    VisitBSTNode visit;
+    ReduceBSTNode reduce;
+    void *extra;
+
+    BSTWORKER *workers;
+    int threads;
+
+    // Nodes not visited yet, the traversal ends when it reaches 0
+    atomic_long pending;
+    atomic_bool stop;
+};
+
+/*
+    # Input:
+        - worker: Thread of a parallel traversal
+        - node: BSTNode
+    
+    # Description:
+        - Visits node, or adds it to the accumulator of worker
+*/
+void visitBSTParallelNode(BSTWORKER *worker, BSTNODE *node) {
+    BSTPARALLEL *run = worker->run;
+
+    if(run->reduce) run->reduce(node, worker->accumulator, run->extra);
+    else if(run->visit(run->bst, node, run->extra)) atomic_store(&run->stop, true);
+}
+
+/*
+    # Input:
+        - worker: Thread of a parallel traversal
+        - root: Root of a subtree
+    
+    # Description:
+        - Visits the subtree rooted at root. Small subtrees are walked in-order, larger ones
+          leave their right subtree in the deque of worker, where idle threads can steal it,
+          and continue with the left one
+*/
+void runBSTParallelTask(BSTWORKER *worker, BSTNODE *root) {
+    BSTPARALLEL *run = worker->run;
+
+    while(root && !atomic_load_explicit(&run->stop, memory_order_relaxed)) {
+        if(root->size <= BST_PARALLEL_GRAIN) {
+            int count = root->size;
+
+            BSTNODE *node = getSmallestNode(root);
+            for(int i = 0; i < count; i++, node = getBSTNodeSuccessor(node)) visitBSTParallelNode(worker, node);
+
+            atomic_fetch_sub(&run->pending, count);
+            return;
+        }
+
+        if(root->rightChild) {
+            pthread_mutex_lock(&worker->lock);
+            bool pushed = insertEndDeque(worker->tasks, root->rightChild);
+            pthread_mutex_unlock(&worker->lock);
+
+            // Without room in the deque the right subtree is visited by this thread
+            if(!pushed) runBSTParallelTask(worker, root->rightChild);
+        }
+
+        visitBSTParallelNode(worker, root);
+        atomic_fetch_sub(&run->pending, 1);
+
+        root = root->leftChild;
+    }
+}
+
+/*
+    # Description:
+        - Thread function, takes subtrees from the deque of its worker, newest first,
+          or steals the oldest subtree of another worker until every node was visited
+*/
+void *runBSTWorker(void *argument) {
+    BSTWORKER *worker = (BSTWORKER *) argument;
+    BSTPARALLEL *run = worker->run;
+
+    while(atomic_load(&run->pending) > 0 && !atomic_load(&run->stop)) {
+        pthread_mutex_lock(&worker->lock);
+        BSTNODE *root = (BSTNODE *) popEndDeque(worker->tasks);
+        pthread_mutex_unlock(&worker->lock);
+
+        for(int i = 1; !root && i < run->threads; i++) {
+            BSTWORKER *victim = &run->workers[(worker->index + i) % run->threads];
+
+            pthread_mutex_lock(&victim->lock);
+            root = (BSTNODE *) popDeque(victim->tasks);
+            pthread_mutex_unlock(&victim->lock);
+        }
+
+        if(root) runBSTParallelTask(worker, root);
+        else sched_yield();
+    }
+
+    return NULL;
+}
+
+/*
+    # Input:
+        - run: Parallel traversal, with the fields set except workers
+        - accumulators: Array with an accumulator per thread, NULL if run visits nodes
+        - accumulatorSize: Size in bytes of each accumulator
+    
+    # Description:
+        - Visits every node of the BST of run with run->threads threads, the calling
+          thread is one of them
+
+        - The accumulators are packed in the array of the caller, each thread reduces into
+          a copy that starts at its own cache line and the copies are written back at the end
+
+        - If threads can't be created the traversal continues with fewer threads
+
+        - Returns false if memory could not be allocated
+*/
+bool runBSTParallel(BSTPARALLEL *run, void *accumulators, size_t accumulatorSize) {
+    BSTTREE *tree = (BSTTREE *) run->bst;
+    if(!tree->root) return true;
+
+    size_t stride = (accumulatorSize + BST_CACHE_LINE - 1) / BST_CACHE_LINE * BST_CACHE_LINE;
+    char *copies = (accumulators) ? (char *) aligned_alloc(BST_CACHE_LINE, run->threads * stride) : NULL;
+
+    run->workers = (BSTWORKER *) aligned_alloc(_Alignof(BSTWORKER), run->threads * sizeof(BSTWORKER));
+    pthread_t *threads = (pthread_t *) malloc(run->threads * sizeof(pthread_t));
+    bool *started = (bool *) calloc(run->threads, sizeof(bool));
+    if(!run->workers || !threads || !started || (accumulators && !copies)) {
+        reportError("ERROR: Could not allocate memory for parallel traversal -- runBSTParallel --\n");
+        free(run->workers);
+        free(threads);
+        free(started);
+        free(copies);
+        return false;
+    }
+
+    int created = 0;
+    for(; created < run->threads; created++) {
+        BSTWORKER *worker = &run->workers[created];
+
+        worker->run = run;
+        worker->index = created;
+        worker->accumulator = (copies) ? copies + created * stride : NULL;
+        if(copies) memcpy(worker->accumulator, (char *) accumulators + created * accumulatorSize, accumulatorSize);
+
+        worker->tasks = newDeque();
+        if(!worker->tasks) break;
+
+        pthread_mutex_init(&worker->lock, NULL);
+    }
+
+    bool ok = created == run->threads;
+
+    if(ok) {
+        atomic_store(&run->pending, tree->root->size);
+        atomic_store(&run->stop, false);
+
+        insertEndDeque(run->workers[0].tasks, tree->root);
+
+        for(int i = 1; i < run->threads; i++) started[i] = !pthread_create(&threads[i], NULL, runBSTWorker, &run->workers[i]);
+
+        runBSTWorker(&run->workers[0]);
+
+        for(int i = 1; i < run->threads; i++) {
+            if(started[i]) pthread_join(threads[i], NULL);
+        }
+
+        for(int i = 0; copies && i < run->threads; i++) {
+            memcpy((char *) accumulators + i * accumulatorSize, copies + i * stride, accumulatorSize);
+        }
+    }
+    else reportError("ERROR: Could not allocate memory for parallel traversal -- runBSTParallel --\n");
+
+    for(int i = 0; i < created; i++) {
+        destroyDeque(run->workers[i].tasks);
+        pthread_mutex_destroy(&run->workers[i].lock);
+    }
+
+    free(run->workers);
+    free(threads);
+    free(started);
+    free(copies);
+
+    return ok;
+}
+
+void parallelForEachBST(BST bst, VisitBSTNode visit, void *extra, int threads) {
+    if(PARAMETER_CHECK(!bst || !visit || threads < 1)) {
+        reportError("WARNING: Invalid parameters -- parallelForEachBST --\n");
+        return;
+    }
+
+    BSTPARALLEL run = {.bst = bst, .visit = visit, .extra = extra, .threads = threads};
+
+    // The nodes are visited by the calling thread if the traversal can't start
+    if(!runBSTParallel(&run, NULL, 0)) preOrderBSTTraversal(bst, visit, extra);
+}
+
+bool parallelReduceBST(BST bst, ReduceBSTNode reduce, CombineBSTAccumulators combine, void *accumulators, size_t accumulatorSize, int threads, void *extra) {
+    if(PARAMETER_CHECK(!bst || !reduce || !combine || !accumulators || !accumulatorSize || threads < 1)) {
+        reportError("WARNING: Invalid parameters -- parallelReduceBST --\n");
+        return false;
+    }
+
+    BSTPARALLEL run = {.bst = bst, .reduce = reduce, .extra = extra, .threads = threads};
+
+    if(!runBSTParallel(&run, accumulators, accumulatorSize)) return false;
+
+    for(int i = 1; i < threads; i++) combine(accumulators, (char *) accumulators + i * accumulatorSize, extra);
+
+    return true;
+}
+
+BSTNode bstIterBegin(BST bst) {
+    if(PARAMETER_CHECK(!bst)) {
+        reportError("WARNING: Invalid parameter -- bstIterBegin --\n");
+        return NULL;
+    }
+
+    BSTTREE *tree = (BSTTREE *) bst;
+
+    return (tree->root) ? getSmallestNode(tree->root) : NULL;
+}
+
+BSTNode bstIterNext(BSTNode node) {
+    if(PARAMETER_CHECK(!node)) {
+        reportError("WARNING: Invalid parameter -- bstIterNext --\n");
+        return NULL;
+    }
+
+    return getBSTNodeSuccessor(node);
+}
+
+void reverseBST(BST bst) {
+    if(PARAMETER_CHECK(!bst)) {
+        reportError("WARNING: Invalid parameter -- reverseBST --\n");
+        return;
+    }
+
+    BSTTREE *tree = (BSTTREE *) bst;
+
+    if(tree->frozen) {
+        reportError("WARNING: BST is frozen -- reverseBST --\n");
+        return;
+    }
+
+    // Children are swapped before moving on, so the walk continues in the mirrored tree
+    for(BSTNODE *node = tree->root; node; node = getBSTPreOrderNext(node)) {
+        BSTNODE *temp = node->leftChild;
+        node->leftChild = node->rightChild;
+        node->rightChild = temp;
+    }
+}
+
+/*
+    # Input:
+        - pool: Pool the nodes were allocated from
+        - root: Root of a subtree without parent
+    
+    # Description:
+        - Returns every node of the subtree rooted at root to pool
+*/
+void freeBSTNodes(Pool pool, BSTNODE *root) {
+    if(!root) return;
+
+    // Children are freed before their parent, which still links to the next node
+    for(BSTNODE *node = getBSTPostOrderFirst(root), *next; node; node = next) {
+        next = getBSTPostOrderNext(node);
+        freePool(pool, node);
+    }
+}
+
+/*
+    # Input:
+        - node: BSTNode
+        - left: Where the left subtree of node is stored
+        - right: Where the right subtree of node is stored
+    
+    # Description:
+        - Detaches node from its children, which become subtrees
+          without parent
+*/
+void exposeBSTNode(BSTNODE *node, BSTNODE **left, BSTNODE **right) {
+    *left = node->leftChild;
+    *right = node->rightChild;
+
+    if(*left) (*left)->parent = NULL;
+    if(*right) (*right)->parent = NULL;
+
+    node->leftChild = NULL;
+    node->rightChild = NULL;
+    node->parent = NULL;
+}
+
+/*
+    # Input:
+        - tree: BST that decides the balancing, rotations at the top change its root
+        - left: Root of a subtree without parent, can be NULL
+        - middle: Node without children and parent
+        - right: Root of a subtree without parent, can be NULL
+    
+    # Description:
+        - Returns the root of a subtree with the nodes of left, then middle,
+          then the nodes of right in-order
+
+        - Every element of left must be <= the element of middle and every
+          element of right must be > it
+
+        - If tree is balanced, middle is placed on the spine of the taller subtree
+          where the heights match and the path above it is rebalanced, so it runs
+          in O(difference of heights)
+*/
+BSTNODE *joinBSTNodes(BSTTREE *tree, BSTNODE *left, BSTNODE *middle, BSTNODE *right) {
+    int leftHeight = getBSTHeightInline(left);
+    int rightHeight = getBSTHeightInline(right);
+
+    BSTNODE *parent = NULL;
+
+    middle->leftChild = left;
+    middle->rightChild = right;
+
+    if(tree->balanced && leftHeight > rightHeight + 1) {
+        // Descend the right spine of left to the first subtree as tall as right,
+        // middle takes its place with it as left child
+        for(parent = left; getBSTHeightInline(parent->rightChild) > rightHeight + 1; parent = parent->rightChild);
+
+        middle->leftChild = parent->rightChild;
+        parent->rightChild = middle;
+    }
+    else if(tree->balanced && rightHeight > leftHeight + 1) {
+        for(parent = right; getBSTHeightInline(parent->leftChild) > leftHeight + 1; parent = parent->leftChild);
+
+        middle->rightChild = parent->leftChild;
+        parent->leftChild = middle;
+    }
+
+    middle->parent = parent;
+    if(middle->leftChild) middle->leftChild->parent = middle;
+    if(middle->rightChild) middle->rightChild->parent = middle;
+
+    updateBSTNode(middle);
+    if(!parent) return middle;
+
+    rebalanceBST(tree, parent);
+
+    // The path from middle to the top is as long as the descent
+    BSTNODE *root;
+    for(root = middle; root->parent; root = root->parent);
+
+    return root;
+}
+
+/*
+    # Input:
+        - tree: BST that decides the balancing
+        - root: Root of a subtree without parent
+        - last: Where the node with the largest element is stored
+    
+    # Description:
+        - Detaches the node with the largest element of the subtree rooted at root
+          and returns the root of the remaining subtree
+*/
+BSTNODE *splitBSTLast(BSTTREE *tree, BSTNODE *root, BSTNODE **last) {
+    if(!tree->balanced) {
+        // The right spine of an unbalanced subtree can be as long as its size,
+        // the largest node is unlinked in place
+        BSTNODE *node;
+        for(node = root; node->rightChild; node = node->rightChild);
+
+        BSTNODE *parent = node->parent;
+        BSTNODE *left = node->leftChild;
+
+        if(parent) parent->rightChild = left;
+        else root = left;
+
+        if(left) left->parent = parent;
+
+        node->leftChild = NULL;
+        node->parent = NULL;
+        updateBSTNode(node);
+
+        recalculateHeight(parent);
+
+        *last = node;
+        return root;
+    }
+
+    BSTNODE *left, *right;
+    exposeBSTNode(root, &left, &right);
+
+    if(!right) {
+        *last = root;
+        return left;
+    }
+
+    BSTNODE *rest = splitBSTLast(tree, right, last);
+
+    return joinBSTNodes(tree, left, root, rest);
+}
+
+/*
+    # Input:
+        - tree: BST that decides the balancing
+        - left: Root of a subtree without parent, can be NULL
+        - right: Root of a subtree without parent, can be NULL
+    
+    # Description:
+        - Same as joinBSTNodes without a middle node, the largest node
+          of left takes its place
+*/
+BSTNODE *joinBSTPair(BSTTREE *tree, BSTNODE *left, BSTNODE *right) {
+    if(!left) return right;
+    if(!right) return left;
+
+    BSTNODE *last;
+    left = splitBSTLast(tree, left, &last);
+
+    return joinBSTNodes(tree, left, last, right);
+}
+
+/*
+    # Input:
+        - tree: Unbalanced BST that decides the order of the elements
+        - root: Root of a subtree without parent, can be NULL
+        - element: Element the subtree is split at
+        - equal: Where the node with element is stored, can be NULL
+        - right: Where the root of the subtree with the elements > element is stored
+    
+    # Description:
+        - Same as splitBSTNodes for unbalanced BSTs, without recursion
+
+        - The path from root to element is walked once, each node on it is appended to
+          the right spine of the left subtree or to the left spine of the right subtree
+*/
+BSTNODE *splitUnbalancedBSTNodes(BSTTREE *tree, BSTNODE *root, BSTElement element, BSTNODE **equal, BSTNODE **right) {
+    BSTNODE *leftRoot = NULL, *rightRoot = NULL;
+
+    // Last nodes appended to each side, the next node goes below them
+    BSTNODE *leftLast = NULL, *rightLast = NULL;
+
+    if(equal) *equal = NULL;
+
+    BSTNODE *node = root;
+    while(node) {
+        int comparison = tree->compare(element, node->element);
+
+        BSTNODE *leftChild = node->leftChild;
+        BSTNODE *rightChild = node->rightChild;
+
+        if(equal && comparison == 0) {
+            *equal = node;
+            exposeBSTNode(node, &leftChild, &rightChild);
+
+            if(leftLast) leftLast->rightChild = leftChild;
+            else leftRoot = leftChild;
+            if(leftChild) leftChild->parent = leftLast;
+
+            if(rightLast) rightLast->leftChild = rightChild;
+            else rightRoot = rightChild;
+            if(rightChild) rightChild->parent = rightLast;
+
+            break;
+        }
+
+        if(comparison <= 0) {
+            // node and its right subtree go to the right side
+            if(rightLast) rightLast->leftChild = node;
+            else rightRoot = node;
+
+            node->parent = rightLast;
+            node->leftChild = NULL;
+            rightLast = node;
+
+            node = leftChild;
+        }
+        else {
+            if(leftLast) leftLast->rightChild = node;
+            else leftRoot = node;
+
+            node->parent = leftLast;
+            node->rightChild = NULL;
+            leftLast = node;
+
+            node = rightChild;
+        }
+    }
+
+    // Only the nodes on the spines changed
+    recalculateHeight(leftLast);
+    recalculateHeight(rightLast);
+
+    *right = rightRoot;
 
-    if(visit) visit(bst, node, extra);
-    preOrder(bst, getBSTNodeLeftNode(node), visit, extra);
-    preOrder(bst, getBSTNodeRightNode(node), visit, extra);
+    return leftRoot;
 }
 
-void preOrderBSTTraversal(BST bst, VisitBSTNode visit, void *extra) {
-    if(!bst) {
-        printf("WARNING: Invalid parameter -- preOrderBSTTraversal --\n");
-        return;
+/*
+    # Input:
+        - tree: BST that decides the balancing and the order of the elements
+        - root: Root of a subtree without parent, can be NULL
+        - element: Element the subtree is split at
+        - equal: Where the node with element is stored, can be NULL
+        - right: Where the root of the subtree with the elements > element is stored
+    
+    # Description:
+        - Splits the subtree rooted at root and returns the root of the subtree
+          with the elements < element
+
+        - If equal is NULL, the nodes with element go to the right subtree.
+          Otherwise one node with element, if any, is detached and stored in equal
+
+        - Each level joins subtrees of similar heights, so it runs in O(height of root)
+
+        - Unbalanced BSTs are split by splitUnbalancedBSTNodes, recursion is only used
+          on AVL trees, which are O(log n) high
+*/
+BSTNODE *splitBSTNodes(BSTTREE *tree, BSTNODE *root, BSTElement element, BSTNODE **equal, BSTNODE **right) {
+    if(!tree->balanced) return splitUnbalancedBSTNodes(tree, root, element, equal, right);
+
+    if(!root) {
+        if(equal) *equal = NULL;
+        *right = NULL;
+
+        return NULL;
+    }
+
+    BSTNODE *leftChild, *rightChild;
+    exposeBSTNode(root, &leftChild, &rightChild);
+
+    int comparison = tree->compare(element, root->element);
+
+    if(equal && comparison == 0) {
+        *equal = root;
+        *right = rightChild;
+
+        return leftChild;
+    }
+
+    if(comparison <= 0) {
+        BSTNODE *middle;
+        BSTNODE *left = splitBSTNodes(tree, leftChild, element, equal, &middle);
+
+        *right = joinBSTNodes(tree, middle, root, rightChild);
+
+        return left;
     }
 
-    preOrder(bst, getBSTRoot(bst), visit, extra);
+    BSTNODE *middle = splitBSTNodes(tree, rightChild, element, equal, right);
+
+    return joinBSTNodes(tree, leftChild, root, middle);
 }
 
-void postOrder(BST bst, BSTNODE *node, VisitBSTNode visit, void *extra) {
-    if(!node) return;
+/*
+    # Input:
+        - tree: BST
+        - node: Root of a subtree without parent, can be NULL
+        - failed: Set to true if memory could not be allocated
+    
+    # Description:
+        - Returns the root of a copy of the subtree rooted at node,
+          with its nodes allocated from the pool of tree
+
+        - The subtree and its copy are walked together in pre-order, climbing back
+          by their parent links, so unbalanced subtrees of any height can be copied
+
+        - If memory could not be allocated, the copy is left incomplete
+*/
+BSTNODE *copyBSTNodes(BSTTREE *tree, BSTNODE *node, bool *failed) {
+    if(!node) return NULL;
+
+    BSTNODE *root = newBSTNode(tree);
+    BSTNODE *copy = root;
+
+    while(copy) {
+        copy->element = node->element;
+        copy->height = node->height;
+        copy->size = node->size;
+
+        // The left subtree is copied first, then the right one, then the walk climbs back
+        BSTNODE **link;
+
+        if(node->leftChild && !copy->leftChild) {
+            link = &copy->leftChild;
+            node = node->leftChild;
+        }
+        else if(node->rightChild && !copy->rightChild) {
+            link = &copy->rightChild;
+            node = node->rightChild;
+        }
+        else {
+            if(copy == root) return root;
+
+            node = node->parent;
+            copy = copy->parent;
+            continue;
+        }
+
+        *link = newBSTNode(tree);
+        if(*link) (*link)->parent = copy;
+
+        copy = *link;
+    }
 
-    postOrder(bst, getBSTNodeLeftNode(node), visit, extra);
-    postOrder(bst, getBSTNodeRightNode(node), visit, extra);
-    if(visit) visit(bst, node, extra);
+    *failed = true;
+
+    return root;
 }
 
-void postOrderBSTTraversal(BST bst, VisitBSTNode visit, void *extra) {
-    if(!bst) {
-        printf("WARNING: Invalid parameter -- postOrderBSTTraversal --\n");
-        return;
+/*
+    # Input:
+        - root: Root of a subtree, can be NULL
+    
+    # Description:
+        - Turns the subtree rooted at root into a list of its nodes in-order, linked
+          by their right child, and returns its first node
+
+        - Rotates right every node with a left child, so it runs in O(n) without recursion.
+          The parent links and heights are left outdated
+*/
+BSTNODE *flattenBSTNodes(BSTNODE *root) {
+    BSTNODE head = {0};
+    head.rightChild = root;
+
+    for(BSTNODE *tail = &head, *node = root; node; ) {
+        if(node->leftChild) {
+            BSTNODE *left = node->leftChild;
+
+            node->leftChild = left->rightChild;
+            left->rightChild = node;
+
+            tail->rightChild = left;
+            node = left;
+        }
+        else {
+            tail = node;
+            node = node->rightChild;
+        }
     }
 
-    postOrder(bst, getBSTRoot(bst), visit, extra);
+    return head.rightChild;
 }
 
 /*
     # Input:
-        - root: Root node from a BST
+        - list: First node of a list linked by right child, it is advanced past the nodes used
+        - count: Number of nodes
     
     # Description:
-        - Reverse the bst with root as its root node
+        - Links the next count nodes of list as a height-balanced subtree and returns its root
 */
-void reverseBSTTree(BSTNODE *root) {
-    if(!root) return;
+BSTNODE *linkBSTNodeList(BSTNODE **list, int count) {
+    if(count <= 0) return NULL;
+
+    BSTNODE *left = linkBSTNodeList(list, (count - 1) / 2);
+
+    BSTNODE *node = *list;
+    *list = node->rightChild;
 
-    BSTNODE *temp = root->leftChild;
-    root->leftChild = root->rightChild;
-    root->rightChild = temp;
+    node->leftChild = left;
+    if(left) left->parent = node;
 
-    reverseBSTTree(root->leftChild);
-    reverseBSTTree(root->rightChild);
+    node->rightChild = linkBSTNodeList(list, count / 2);
+    if(node->rightChild) node->rightChild->parent = node;
+
+    node->parent = NULL;
+    updateBSTNode(node);
+
+    return node;
 }
 
-void reverseBST(BST bst) {
-    if(!bst) {
-        printf("WARNING: Invalid parameter -- reverseBST --\n");
-        return;
+/*
+    # Input:
+        - root: Root of a subtree without parent, can be NULL
+    
+    # Description:
+        - Relinks the subtree rooted at root height-balanced and returns its new root,
+          in O(n) without recursion on the height of the subtree
+*/
+BSTNODE *balanceBSTNodes(BSTNODE *root) {
+    int count = getBSTNodeSize(root);
+    BSTNODE *list = flattenBSTNodes(root);
+
+    return linkBSTNodeList(&list, count);
+}
+
+/*
+    # Input:
+        - tree: BST
+        - other: BST whose nodes will be linked into tree
+    
+    # Description:
+        - Makes the nodes of other belong to the pool of tree:
+            - Nothing to do if they share a pool
+            - The pool of other is merged into the pool of tree if possible (see mergePool)
+            - Otherwise the nodes of other are replaced by copies from the pool of tree
+
+        - If tree is balanced and other is not, the nodes of other are relinked
+          height-balanced in O(m), so tree stays balanced once they are linked
+
+        - Returns false, and changes nothing, if memory could not be allocated
+*/
+bool adoptBSTNodes(BSTTREE *tree, BSTTREE *other) {
+    if(tree->pool != other->pool && !mergePool(tree->pool, other->pool)) {
+        bool failed = false;
+        BSTNODE *copy = copyBSTNodes(tree, other->root, &failed);
+
+        if(failed) {
+            reportError("ERROR: Could not allocate memory for BST nodes -- adoptBSTNodes --\n");
+            freeBSTNodes(tree->pool, copy);
+            return false;
+        }
+
+        freeBSTNodes(other->pool, other->root);
+        other->root = copy;
+    }
+
+    // Linking a degenerate subtree as it is would leave tree unbalanced
+    if(tree->balanced && !other->balanced) other->root = balanceBSTNodes(other->root);
+
+    return true;
+}
+
+bool joinBST(BST bst, BST other) {
+    if(PARAMETER_CHECK(!bst || !other || bst == other)) {
+        reportError("WARNING: Invalid parameters -- joinBST --\n");
+        return false;
+    }
+
+    BSTTREE *tree = (BSTTREE *) bst;
+    BSTTREE *otherTree = (BSTTREE *) other;
+
+    if(tree->frozen || otherTree->frozen) {
+        reportError("WARNING: BST is frozen -- joinBST --\n");
+        return false;
+    }
+
+    if(!otherTree->root) return true;
+
+    if(tree->root) {
+        BSTNODE *largest;
+        for(largest = tree->root; largest->rightChild; largest = largest->rightChild);
+
+        // Checked even with DS_NO_CHECKS, joining out of order would break every later search
+        // and the check costs O(height) like the join itself
+        if(tree->compare(largest->element, getSmallestNode(otherTree->root)->element) > 0) {
+            reportError("WARNING: Elements of other are not after the elements of bst -- joinBST --\n");
+            return false;
+        }
+    }
+
+    if(!adoptBSTNodes(tree, otherTree)) return false;
+
+    BSTNODE *root = joinBSTPair(tree, tree->root, otherTree->root);
+
+    tree->root = root;
+    otherTree->root = NULL;
+
+    return true;
+}
+
+bool splitBST(BST bst, BSTElement element, BST *left, BST *right) {
+    if(PARAMETER_CHECK(!bst || !element || !left || !right)) {
+        reportError("WARNING: Invalid parameters -- splitBST --\n");
+        return false;
     }
 
     BSTTREE *tree = (BSTTREE *) bst;
 
-    reverseBST(tree);
+    if(tree->frozen) {
+        reportError("WARNING: BST is frozen -- splitBST --\n");
+        return false;
+    }
+
+    BSTTREE *leftTree = (BSTTREE *) newBSTSharedPool(bst);
+    BSTTREE *rightTree = (BSTTREE *) newBSTSharedPool(bst);
+    if(!leftTree || !rightTree) {
+        destroyBST(leftTree);
+        destroyBST(rightTree);
+        return false;
+    }
+
+    BSTNODE *rightRoot;
+    BSTNODE *leftRoot = splitBSTNodes(tree, tree->root, element, NULL, &rightRoot);
+
+    leftTree->root = leftRoot;
+    rightTree->root = rightRoot;
+    tree->root = NULL;
+
+    *left = leftTree;
+    *right = rightTree;
+
+    return true;
+}
+
+typedef enum {BST_UNION, BST_INTERSECTION, BST_DIFFERENCE} BSTSETOPERATION;
+
+/*
+    - Part of a set operation, run by combineBSTNodes in the calling thread
+      or in a thread of its own
+*/
+typedef struct {
+    // Copy of the result BST, rotations at the top of a subtree change its root
+    BSTTREE tree;
+    BSTSETOPERATION operation;
+    BSTNODE *first, *second, *result;
+    int threads;
+
+    // Subtrees removed from the result, linked by the parent of their roots. They are
+    // freed by the calling thread at the end, the pool can't be used by several threads
+    BSTNODE *dropped;
+}BSTSETTASK;
+
+/*
+    # Input:
+        - task: Set operation
+        - root: Root of a subtree without parent
+    
+    # Description:
+        - Removes the subtree rooted at root from the result of task
+*/
+void dropBSTNodes(BSTSETTASK *task, BSTNODE *root) {
+    root->parent = task->dropped;
+    task->dropped = root;
+}
+
+BSTNODE *combineBSTNodes(BSTSETTASK *task, BSTNODE *first, BSTNODE *second, int threads);
+
+/*
+    # Description:
+        - Thread function, runs task
+*/
+void *runBSTSetTask(void *argument) {
+    BSTSETTASK *task = (BSTSETTASK *) argument;
+
+    task->result = combineBSTNodes(task, task->first, task->second, task->threads);
+
+    return NULL;
+}
+
+/*
+    # Input:
+        - task: Set operation
+        - first: Root of a subtree of the result BST without parent, can be NULL
+        - second: Root of a subtree of the other BST, can be NULL
+        - threads: Number of threads the operation can use
+    
+    # Description:
+        - Returns the root of the subtree with the result of the operation
+          of task on first and second
+
+        - first is split at the root of second and each half is combined with
+          the matching subtree of second, so it runs in O(m log(n / m + 1)),
+          m and n being the sizes of the smaller and the larger subtree
+
+        - The 2 halves are independent, if threads > 1 and the subtrees are large
+          one of them runs in a new thread
+
+        - For a union the nodes of second are moved to the result, otherwise
+          second is only read
+*/
+BSTNODE *combineBSTNodes(BSTSETTASK *task, BSTNODE *first, BSTNODE *second, int threads) {
+    if(!first || !second) {
+        if(task->operation == BST_UNION) return (first) ? first : second;
+
+        if(task->operation == BST_INTERSECTION) {
+            if(first) dropBSTNodes(task, first);
+            return NULL;
+        }
+
+        return first;
+    }
+
+    bool parallel = threads > 1 && getBSTNodeSize(first) + getBSTNodeSize(second) >= BST_PARALLEL_MIN_SIZE;
+
+    BSTNODE *secondLeft = second->leftChild;
+    BSTNODE *secondRight = second->rightChild;
+    if(task->operation == BST_UNION) exposeBSTNode(second, &secondLeft, &secondRight);
+
+    BSTNODE *equal, *firstRight;
+    BSTNODE *firstLeft = splitBSTNodes(&task->tree, first, second->element, &equal, &firstRight);
+
+    BSTNODE *left, *right;
+
+    BSTSETTASK leftTask;
+    pthread_t thread;
+
+    if(parallel) {
+        leftTask = *task;
+        leftTask.first = firstLeft;
+        leftTask.second = secondLeft;
+        leftTask.threads = threads / 2;
+        leftTask.dropped = NULL;
+
+        // Runs in the calling thread if no thread can be created
+        parallel = !pthread_create(&thread, NULL, runBSTSetTask, &leftTask);
+    }
+
+    if(parallel) {
+        right = combineBSTNodes(task, firstRight, secondRight, threads - leftTask.threads);
+
+        pthread_join(thread, NULL);
+        left = leftTask.result;
+
+        if(leftTask.dropped) {
+            BSTNODE *last;
+            for(last = leftTask.dropped; last->parent; last = last->parent);
+
+            last->parent = task->dropped;
+            task->dropped = leftTask.dropped;
+        }
+    }
+    else {
+        left = combineBSTNodes(task, firstLeft, secondLeft, 1);
+        right = combineBSTNodes(task, firstRight, secondRight, 1);
+    }
+
+    switch(task->operation) {
+        case BST_UNION:
+            // The element of the result BST is kept
+            if(!equal) return joinBSTNodes(&task->tree, left, second, right);
+
+            dropBSTNodes(task, second);
+            return joinBSTNodes(&task->tree, left, equal, right);
+
+        case BST_INTERSECTION:
+            if(equal) return joinBSTNodes(&task->tree, left, equal, right);
+            return joinBSTPair(&task->tree, left, right);
+
+        default:
+            if(equal) dropBSTNodes(task, equal);
+            return joinBSTPair(&task->tree, left, right);
+    }
+}
+
+/*
+    # Input:
+        - tree: BST that stores the result
+        - second: Root of the other BST
+        - operation: Set operation
+    
+    # Description:
+        - Same as combineBSTNodes on the whole BSTs, for BSTs too tall to recurse on
+
+        - The elements of both BSTs are merged in-order and the result is relinked
+          height-balanced, so it runs in O(n + m) without recursion. The removed
+          nodes are freed
+
+        - For a union second is flattened and its nodes moved, otherwise second is
+          only read, following its parent links
+*/
+void mergeBSTNodes(BSTTREE *tree, BSTNODE *second, BSTSETOPERATION operation) {
+    BSTNODE *first = flattenBSTNodes(tree->root);
+
+    if(operation == BST_UNION) second = flattenBSTNodes(second);
+    else if(second) second = getSmallestNode(second);
+
+    BSTNODE head = {0};
+    BSTNODE *tail = &head;
+    int count = 0;
+
+    // An element of second matched by one of first is not added to a union
+    bool matched = false;
+
+    while(first || second) {
+        int comparison = (!first) ? 1 : (!second) ? -1 : tree->compare(first->element, second->element);
+
+        if(comparison > 0) {
+            BSTNODE *next = (operation == BST_UNION) ? second->rightChild : (BSTNODE *) getBSTNodeSuccessor(second);
+
+            if(operation == BST_UNION) {
+                if(matched) freePool(tree->pool, second);
+                else {
+                    tail->rightChild = second;
+                    tail = second;
+                    count++;
+                }
+            }
+
+            second = next;
+            matched = false;
+
+            // Only a union keeps elements after the last one of first
+            if(!first && operation != BST_UNION) break;
+
+            continue;
+        }
+
+        BSTNODE *next = first->rightChild;
+
+        bool keep = (comparison < 0) ? operation != BST_INTERSECTION : operation != BST_DIFFERENCE;
+        if(comparison == 0) matched = true;
+
+        if(keep) {
+            tail->rightChild = first;
+            tail = first;
+            count++;
+        }
+        else freePool(tree->pool, first);
+
+        first = next;
+    }
+
+    tail->rightChild = NULL;
+
+    BSTNODE *list = head.rightChild;
+    tree->root = linkBSTNodeList(&list, count);
 }
 
 /*
     # Input:
-        - bst: BST
-        - root: BST node
+        - tree: BST that stores the result
+        - second: Root of the other BST
+        - operation: Set operation
+        - threads: Number of threads the operation can use
     
     # Description:
-        - Destroy all nodes from the BST with root as it root
+        - Replaces the nodes of tree by the result of operation on tree and second,
+          the removed nodes are freed
+
+        - Unbalanced BSTs taller than BST_MAX_RECURSION_HEIGHT are merged by mergeBSTNodes
+          in the calling thread instead, combineBSTNodes recurses once per level of second
+          and splitBSTNodes once per level of tree
 */
-void emptyTree(BST bst, BSTNODE *root) {
-    while(root) {
-        removeBST(bst, root);
-        root = getBSTRoot(bst);
+void runBSTSetOperation(BSTTREE *tree, BSTNODE *second, BSTSETOPERATION operation, int threads) {
+    if(getBSTHeightInline(tree->root) > BST_MAX_RECURSION_HEIGHT || getBSTHeightInline(second) > BST_MAX_RECURSION_HEIGHT) {
+        mergeBSTNodes(tree, second, operation);
+        return;
+    }
+
+    BSTSETTASK task = {*tree, operation, tree->root, second, NULL, threads, NULL};
+
+    runBSTSetTask(&task);
+
+    tree->root = task.result;
+
+    while(task.dropped) {
+        BSTNODE *root = task.dropped;
+        task.dropped = root->parent;
+
+        root->parent = NULL;
+        freeBSTNodes(tree->pool, root);
+    }
+}
+
+bool unionBST(BST bst, BST other, int threads) {
+    if(PARAMETER_CHECK(!bst || !other || bst == other || threads < 1)) {
+        reportError("WARNING: Invalid parameters -- unionBST --\n");
+        return false;
+    }
+
+    BSTTREE *tree = (BSTTREE *) bst;
+    BSTTREE *otherTree = (BSTTREE *) other;
+
+    if(tree->frozen || otherTree->frozen) {
+        reportError("WARNING: BST is frozen -- unionBST --\n");
+        return false;
+    }
+
+    if(!adoptBSTNodes(tree, otherTree)) return false;
+
+    runBSTSetOperation(tree, otherTree->root, BST_UNION, threads);
+    otherTree->root = NULL;
+
+    return true;
+}
+
+void intersectBST(BST bst, BST other, int threads) {
+    if(PARAMETER_CHECK(!bst || !other || bst == other || threads < 1)) {
+        reportError("WARNING: Invalid parameters -- intersectBST --\n");
+        return;
+    }
+
+    BSTTREE *tree = (BSTTREE *) bst;
+    BSTTREE *otherTree = (BSTTREE *) other;
+
+    if(tree->frozen) {
+        reportError("WARNING: BST is frozen -- intersectBST --\n");
+        return;
+    }
+
+    runBSTSetOperation(tree, otherTree->root, BST_INTERSECTION, threads);
+}
+
+void differenceBST(BST bst, BST other, int threads) {
+    if(PARAMETER_CHECK(!bst || !other || bst == other || threads < 1)) {
+        reportError("WARNING: Invalid parameters -- differenceBST --\n");
+        return;
+    }
+
+    BSTTREE *tree = (BSTTREE *) bst;
+    BSTTREE *otherTree = (BSTTREE *) other;
+
+    if(tree->frozen) {
+        reportError("WARNING: BST is frozen -- differenceBST --\n");
+        return;
     }
+
+    runBSTSetOperation(tree, otherTree->root, BST_DIFFERENCE, threads);
 }
 
 void destroyBST(BST bst) {
     if(!bst) return;
 
     BSTTREE *tree = (BSTTREE *) bst;
-    BSTNODE *root = (BSTNODE *) tree->root;
 
-    emptyTree(bst, root);
+    thawBST(bst);
+
+    // Nodes are dropped with the slabs of the pool instead of one by one,
+    // unless other BSTs still use the pool
+    if(isPoolShared(tree->pool)) freeBSTNodes(tree->pool, tree->root);
+
+    destroyPool(tree->pool);
     
     free(tree);
     bst = NULL;
 }
+
+void destroyBSTAndElements(BST bst, DestroyBSTElement destroy) {
+    if(!bst) return;
+
+    if(PARAMETER_CHECK(!destroy)) {
+        reportError("WARNING: Invalid parameter -- destroyBSTAndElements --\n");
+        return;
+    }
+
+    BSTTREE *tree = (BSTTREE *) bst;
+
+    // The nodes are not freed during the walk, so any order works and the parent links
+    // replace a stack
+    for(BSTNODE *node = tree->root; node; node = getBSTPreOrderNext(node)) destroy(node->element);
+
+    destroyBST(bst);
+}
\ No newline at end of file
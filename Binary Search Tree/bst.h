@@ -14,11 +14,28 @@
     - In this module its assumed BST != NULL, BSTElement != NULL and BSTNode != NULL for functions that recieve
       those as parameters 
 
+    - Parameter checks are compiled out when DS_NO_CHECKS is defined (see Common/error.h)
+
+    - BSTNodes are allocated from a node pool owned by the BST, the memory for the pool can come
+      from user supplied functions (see newBSTWithAllocator)
+
+    - BSTs can be joined, split and combined as sets by relinking their BSTNodes (see joinBST,
+      splitBST, unionBST, intersectBST and differenceBST), on balanced BSTs these operations
+      cost O(m log(n / m + 1)) instead of one insertion or removal per element. None of them
+      recurses once per level, so unbalanced BSTs as tall as their size can't overflow the stack
+
+    - A BST that is searched much more than it is changed can be frozen (see freezeBST), searches
+      then run over a copy of its elements laid out in an array. A frozen BST can't be changed
+      until it is thawed, functions that would change it report a warning and do nothing
+
     - It's necessary to free the memory allocated for BST and BSTNode using the functions provided in this module
 */
 
 #include <stdbool.h>
 
+#include "../List/list.h"
+#include "../Pool/pool.h"
+
 typedef void *BST;
 typedef void *BSTNode;
 typedef void *BSTElement;
@@ -39,6 +56,23 @@ typedef int (* CompareElementsBST)(BSTElement el1, BSTElement el2);
 */
 typedef bool (* VisitBSTNode)(BST bst, BSTNode node, void *extra);
 
+/*
+    - Function utilized by destroyBSTAndElements to free a BSTElement
+*/
+typedef void (* DestroyBSTElement)(BSTElement element);
+
+/*
+    - Function utilized by parallelReduceBST to add the element of node
+      to accumulator
+*/
+typedef void (* ReduceBSTNode)(BSTNode node, void *accumulator, void *extra);
+
+/*
+    - Function utilized by parallelReduceBST to add the result held by other
+      to accumulator
+*/
+typedef void (* CombineBSTAccumulators)(void *accumulator, void *other, void *extra);
+
 /*
     # Input:
         - compare: Function to compare BSTElement for new BST
@@ -48,6 +82,90 @@ typedef bool (* VisitBSTNode)(BST bst, BSTNode node, void *extra);
 */
 BST newBST(CompareElementsBST compare);
 
+/*
+    # Input:
+        - compare: Function to compare BSTElement for new BST
+    
+    # Description:
+        - Returns a pointer to a new self-balancing (AVL) BST
+
+        - Insertions and removals rotate the tree so its height
+          stays O(log n), even for sorted input
+*/
+BST newBalancedBST(CompareElementsBST compare);
+
+/*
+    # Input:
+        - compare: Function to compare BSTElement for new BST
+        - balanced: If true, the new BST is self-balancing (see newBalancedBST)
+        - allocate: Function used to allocate memory for the nodes of the BST
+        - release: Function used to free memory allocated by allocate
+        - extra: Extra pointer given to allocate and release if necessary
+    
+    # Description:
+        - Returns a pointer to a new BST whose nodes are allocated
+          in slabs obtained from allocate
+
+        - allocate and release must be both NULL or both != NULL,
+          if both are NULL malloc and free are used
+*/
+BST newBSTWithAllocator(CompareElementsBST compare, bool balanced, AllocateMemory allocate, FreeMemory release, void *extra);
+
+/*
+    # Input:
+        - bst: BST
+    
+    # Description:
+        - Returns a pointer to a new empty BST with the same compare function
+          and balancing as bst, whose nodes are allocated from the same pool
+          as the nodes of bst
+
+        - The pool is freed when the last BST using it is destroyed, while
+          it's shared destroyBST frees the nodes of a BST one by one
+
+        - BSTs sharing a pool can't be changed at the same time from different threads
+*/
+BST newBSTSharedPool(BST bst);
+
+/*
+    # Input:
+        - compare: Function to compare BSTElement for new BST
+        - elements: Array of elements sorted in ascending order by compare
+        - n: Number of elements in elements
+    
+    # Description:
+        - Returns a pointer to a new self-balancing BST (see newBalancedBST)
+          with the n elements
+
+        - The tree is built height-balanced in a single O(n) pass, and all
+          of its nodes are allocated in one block
+
+        - If elements is not sorted, returns NULL
+*/
+BST buildBSTFromSorted(CompareElementsBST compare, BSTElement *elements, int n);
+
+/*
+    # Input:
+        - compare: Function to compare BSTElement for new BST
+        - list: dll with its elements sorted in ascending order by compare
+    
+    # Description:
+        - Same as buildBSTFromSorted, taking the elements of list in order
+
+        - list is not modified
+*/
+BST buildBSTFromList(CompareElementsBST compare, List list);
+
+/*
+    # Input:
+        - bst: BST
+    
+    # Description:
+        - Returns true if bst was created with newBalancedBST,
+          false otherwise
+*/
+bool isBSTBalanced(BST bst);
+
 /*
     # Input:
         - root: Node from a BST
@@ -67,6 +185,15 @@ bool isBSTEmpty(BSTNode root);
 */
 int getBSTHeight(BSTNode root);
 
+/*
+    # Input:
+        - bst: BST
+    
+    # Description:
+        - Returns the number of elements stored in bst
+*/
+int getBSTSize(BST bst);
+
 /*
     # Input:
         - bst: BST
@@ -76,6 +203,8 @@ int getBSTHeight(BSTNode root);
         - Inserts element in bst
 
         - Returns a pointer to the node created for element
+
+        - If bst is frozen, returns NULL
 */
 BSTNode insertBST(BST bst, BSTElement element);
 
@@ -89,6 +218,8 @@ BSTNode insertBST(BST bst, BSTElement element);
           element stored in node
 
         - node must be in bst
+
+        - If bst is frozen, returns NULL and node stays in bst
 */
 BSTElement removeBST(BST bst, BSTNode node);
 
@@ -153,6 +284,154 @@ BSTElement getBSTNodeElement(BSTNode node);
 */
 BSTNode findBSTNodeElement(BST bst, BSTElement element);
 
+/*
+    # Input:
+        - bst: BST
+        - elements: Searched elements
+        - n: Number of elements in elements
+        - nodes: Array with room for n BSTNodes
+    
+    # Description:
+        - Stores in nodes[i] the BSTNode in wich elements[i] is stored,
+          or NULL if elements[i] is not in bst
+
+        - Returns the number of elements found
+
+        - Several lookups are run interleaved, prefetching the next node of each
+          one, so their cache misses overlap. On trees larger than the cache it is
+          faster than calling findBSTNodeElement for each element
+*/
+int findBSTBatch(BST bst, BSTElement *elements, int n, BSTNode *nodes);
+
+/*
+    # Input:
+        - bst: BST
+        - element: Element to be compared, doesn't need to be in bst
+    
+    # Description:
+        - Returns the BSTNode with the smallest element that is >= element
+
+        - If every element in bst is < element, returns NULL
+*/
+BSTNode lowerBoundBST(BST bst, BSTElement element);
+
+/*
+    # Input:
+        - bst: BST
+        - element: Element to be compared, doesn't need to be in bst
+    
+    # Description:
+        - Returns the BSTNode with the smallest element that is > element
+
+        - If every element in bst is <= element, returns NULL
+*/
+BSTNode upperBoundBST(BST bst, BSTElement element);
+
+/*
+    # Input:
+        - bst: BST
+    
+    # Description:
+        - Freezes bst: its elements are copied, in O(n), to an array in Eytzinger order
+          (the root at 1, the children of i at 2i and 2i + 1) next to an array with their BSTNodes
+
+        - While bst is frozen, findBSTNodeElement, lowerBoundBST, upperBoundBST and rangeBST
+          search the array without branching on the comparisons, prefetching the levels below.
+          Its BSTNodes stay valid and traversals keep walking them
+
+        - insertBST, removeBST, joinBST, splitBST, unionBST, intersectBST, differenceBST
+          and reverseBST refuse to change a frozen BST, thawBST must be called first
+
+        - Returns true if bst is already frozen, false if memory could not be allocated
+*/
+bool freezeBST(BST bst);
+
+/*
+    # Input:
+        - bst: BST
+    
+    # Description:
+        - Frees the arrays made by freezeBST, bst can be changed again
+
+        - Does nothing if bst is not frozen
+*/
+void thawBST(BST bst);
+
+/*
+    # Input:
+        - bst: BST
+    
+    # Description:
+        - Returns true if bst is frozen
+*/
+bool isBSTFrozen(BST bst);
+
+/*
+    # Input:
+        - node: BSTNode from bst
+    
+    # Description:
+        - Returns the BSTNode that comes after node in-order
+
+        - If node stores the largest element, returns NULL
+*/
+BSTNode getBSTNodeSuccessor(BSTNode node);
+
+/*
+    # Input:
+        - node: BSTNode from bst
+    
+    # Description:
+        - Returns the BSTNode that comes before node in-order
+
+        - If node stores the smallest element, returns NULL
+*/
+BSTNode getBSTNodePredecessor(BSTNode node);
+
+/*
+    # Input:
+        - bst: BST
+        - lo: Lower bound of the range, inclusive
+        - hi: Upper bound of the range, exclusive
+        - visit: Function to be used during the traversal
+        - extra: Extra pointer if necessary
+    
+    # Description:
+        - Visits in-order every node of bst with an element in [lo, hi)
+
+        - Subtrees outside the range are not visited, so it runs in
+          O(height of bst + number of visited nodes)
+
+        - visit and extra can be NULL
+*/
+void rangeBST(BST bst, BSTElement lo, BSTElement hi, VisitBSTNode visit, void *extra);
+
+/*
+    # Input:
+        - bst: BST
+        - k: Position of the element in the sorted order of bst, starting at 0
+    
+    # Description:
+        - Returns the BSTNode that stores the k-th smallest element of bst
+
+        - Runs in O(height of bst)
+
+        - If k < 0 or k >= size of bst, returns NULL
+*/
+BSTNode selectBST(BST bst, int k);
+
+/*
+    # Input:
+        - bst: BST
+        - element: Element to be ranked, doesn't need to be in bst
+    
+    # Description:
+        - Returns the number of elements in bst that are smaller than element
+
+        - Runs in O(height of bst)
+*/
+int rankBST(BST bst, BSTElement element);
+
 /*
     # Input:
         - bst: BST
@@ -162,6 +441,9 @@ BSTNode findBSTNodeElement(BST bst, BSTElement element);
     # Description:
         - Traverse tree in-order
 
+        - The traversal follows the parent pointers of the nodes, it doesn't
+          use recursion or allocate memory
+
         - visit and extra can be NULL
 */
 void inOrderBSTTraversal(BST bst, VisitBSTNode visit, void *extra);
@@ -175,6 +457,9 @@ void inOrderBSTTraversal(BST bst, VisitBSTNode visit, void *extra);
     # Description:
         - Traverse tree pre-order
 
+        - The traversal follows the parent pointers of the nodes, it doesn't
+          use recursion or allocate memory
+
         - visit and extra can be NULL
 */
 void preOrderBSTTraversal(BST bst, VisitBSTNode visit, void *extra);
@@ -188,10 +473,203 @@ void preOrderBSTTraversal(BST bst, VisitBSTNode visit, void *extra);
     # Description:
         - Traverse tree post-order
 
+        - The traversal follows the parent pointers of the nodes, it doesn't
+          use recursion or allocate memory
+
         - visit and extra can be NULL
 */
 void postOrderBSTTraversal(BST bst, VisitBSTNode visit, void *extra);
 
+/*
+    # Input:
+        - bst: BST
+        - visit: Function to be used during the traversal
+        - extra: Extra pointer if necessary
+        - threads: Number of threads, including the calling thread
+    
+    # Description:
+        - Visits every node of bst once, in no particular order, with
+          several threads at the same time
+
+        - Large subtrees are split in tasks, idle threads steal tasks from
+          busy ones, so uneven subtrees keep every thread working
+
+        - If visit returns true the traversal stops, the other threads stop
+          after the subtree they are walking
+
+        - visit must be safe to call from several threads, and bst must not
+          be changed during the traversal
+
+        - extra can be NULL
+*/
+void parallelForEachBST(BST bst, VisitBSTNode visit, void *extra, int threads);
+
+/*
+    # Input:
+        - bst: BST
+        - reduce: Function that adds a node to the accumulator of its thread
+        - combine: Function that adds an accumulator to another one
+        - accumulators: Array of threads accumulators, each one initialized
+          to the empty result
+        - accumulatorSize: Size in bytes of each accumulator
+        - threads: Number of threads, including the calling thread
+        - extra: Extra pointer if necessary
+    
+    # Description:
+        - Same as parallelForEachBST, each thread adds the nodes it visits to its
+          own accumulator with reduce, no locking is needed inside reduce
+
+        - reduce receives a copy of the accumulator of its thread that starts at its own
+          cache line, so packed accumulators are not written by several threads at once.
+          The copies are stored back in accumulators before they are combined
+
+        - At the end every accumulator is combined into accumulators[0], in order
+
+        - Returns false, and reduces nothing, if memory could not be allocated
+
+        - Ex: Sum of elements, with long accumulators[threads] = {0}:
+              reduce adds the element of node to *(long *) accumulator,
+              combine adds *(long *) other to *(long *) accumulator
+*/
+bool parallelReduceBST(BST bst, ReduceBSTNode reduce, CombineBSTAccumulators combine, void *accumulators, size_t accumulatorSize, int threads, void *extra);
+
+/*
+    # Input:
+        - bst: BST
+    
+    # Description:
+        - Returns the first BSTNode of bst in-order, to be used as a cursor
+          with bstIterNext
+
+        - If bst is empty, returns NULL
+
+        - Ex: for(BSTNode node = bstIterBegin(bst); node; node = bstIterNext(node)) { ... }
+*/
+BSTNode bstIterBegin(BST bst);
+
+/*
+    # Input:
+        - node: BSTNode from bst, the current position of the cursor
+    
+    # Description:
+        - Returns the BSTNode that comes after node in-order
+
+        - If node is the last one, returns NULL
+
+        - The cursor is the node itself, it remains valid while node is in bst
+*/
+BSTNode bstIterNext(BSTNode node);
+
+/*
+    # Input:
+        - bst: BST
+        - other: BST, != bst, with every element >= the elements of bst
+    
+    # Description:
+        - Moves every node of other to bst, other is left empty
+
+        - The nodes are relinked, each BSTNode keeps its element and stays valid.
+          If bst is balanced it runs in O(log n + difference of heights), n being
+          the size of bst, as the largest node of bst is detached first to link
+          the 2 BSTs. Otherwise it runs in O(height of bst)
+
+        - If bst is balanced and other is not, the nodes of other are first relinked
+          height-balanced in O(size of other), so bst stays balanced
+
+        - If the nodes of other can't move to the pool of bst (see mergePool),
+          they are copied to it first in O(size of other) and the BSTNodes
+          of other are freed
+
+        - Returns false, and changes nothing, if the elements are not in order
+          or memory could not be allocated. The order is checked in O(height)
+          even when DS_NO_CHECKS is defined
+*/
+bool joinBST(BST bst, BST other);
+
+/*
+    # Input:
+        - bst: BST
+        - element: Element bst is split at, doesn't need to be in bst
+        - left: Where the BST with the elements < element is stored
+        - right: Where the BST with the elements >= element is stored
+    
+    # Description:
+        - Moves the nodes of bst to 2 new BSTs that share the pool of bst,
+          bst is left empty
+
+        - The nodes are relinked, each BSTNode keeps its element and stays valid.
+          If bst is balanced it runs in O(log n), otherwise in O(height of bst)
+
+        - Returns false, and changes nothing, if memory could not be allocated
+
+        - Ex: If bst = {1, 3, 5, 7} and element = 5, left will be: {1, 3} and right: {5, 7}
+*/
+bool splitBST(BST bst, BSTElement element, BST *left, BST *right);
+
+/*
+    # Input:
+        - bst: BST
+        - other: BST, != bst, ordered by the same compare function as bst
+        - threads: Maximum number of threads used, 1 to run only in the calling thread
+    
+    # Description:
+        - Moves to bst the nodes of other whose elements are not in bst, the remaining
+          nodes of other are freed, but not their elements, and other is left empty
+
+        - Elements that compare equal are treated as the same element, bst keeps its own
+
+        - Moved nodes are relinked as in joinBST, if bst and other are balanced it runs in
+          O(m log(n / m + 1)), m and n being the sizes of the smaller and the larger BST
+
+        - If bst is balanced and other is not, the nodes of other are first relinked
+          height-balanced in O(size of other), so bst stays balanced
+
+        - If bst or other is unbalanced and more than 128 levels tall, both are merged
+          in-order in O(n + m) in the calling thread and bst is relinked height-balanced
+
+        - With threads > 1 independent parts of large BSTs are combined in parallel,
+          compare must then be safe to call from several threads
+
+        - Returns false, and changes nothing, if memory could not be allocated
+
+        - Ex: If bst = {1, 3, 5} and other = {3, 4}, bst will be: {1, 3, 4, 5}
+*/
+bool unionBST(BST bst, BST other, int threads);
+
+/*
+    # Input:
+        - bst: BST
+        - other: BST, != bst, ordered by the same compare function as bst
+        - threads: Maximum number of threads used, 1 to run only in the calling thread
+    
+    # Description:
+        - Removes from bst the elements that are not in other, other is not changed
+
+        - The removed nodes are freed, but not their elements
+
+        - Same cost and use of threads as unionBST
+
+        - Ex: If bst = {1, 3, 5} and other = {3, 4, 5}, bst will be: {3, 5}
+*/
+void intersectBST(BST bst, BST other, int threads);
+
+/*
+    # Input:
+        - bst: BST
+        - other: BST, != bst, ordered by the same compare function as bst
+        - threads: Maximum number of threads used, 1 to run only in the calling thread
+    
+    # Description:
+        - Removes from bst the elements that are in other, other is not changed
+
+        - The removed nodes are freed, but not their elements
+
+        - Same cost and use of threads as unionBST
+
+        - Ex: If bst = {1, 3, 5} and other = {3, 4, 5}, bst will be: {1}
+*/
+void differenceBST(BST bst, BST other, int threads);
+
 /*
     # Input:
         - bst: BST
@@ -210,4 +688,21 @@ void reverseBST(BST bst);
 */
 void destroyBST(BST bst);
 
+/*
+    # Input:
+        - bst: BST
+        - destroy: Function called for every element of bst
+    
+    # Description:
+        - Calls destroy for every element of bst and frees all the memory
+          used by bst, in a single O(n) walk without recursion
+
+        - Ex: destroyBSTAndElements(bst, free) frees elements allocated with malloc
+*/
+void destroyBSTAndElements(BST bst, DestroyBSTElement destroy);
+
+#ifdef DS_NO_CHECKS
+#include "bst_inline.h"
+#endif
+
 #endif
\ No newline at end of file
@@ -0,0 +1,727 @@
+#ifndef BST_GENERIC_H
+#define BST_GENERIC_H
+
+/*
+    - This module generates self-balancing (AVL) binary search trees(bst) that store keys and
+      values of given types inside their nodes, instead of a BSTElement pointing to memory
+      allocated elsewhere
+
+    - DEFINE_BST(name, K, V, compare) defines, for a bst named name mapping keys of type K
+      to values of type V:
+        - The types name, name##Node and Visit##name. The fields key and value of name##Node
+          can be read directly, and value can be changed
+        - The functions below, with the same algorithms as the balanced BSTs of bst.c: parent
+          links, subtree sizes for rank and select, and join-based split (ex: for
+          DEFINE_BST(PriceTree, int, double, ...), newPriceTree, insertPriceTree, findPriceTree, ...)
+
+    - The children of a node are indexed by the result of a comparison, so descents pick the
+      next child without branching on it
+
+    - compare(a, b) is a function or macro that receives 2 K and returns < 0 if a < b, > 0 if a > b
+      and 0 if they are equal. It is called directly, so it can be inlined in the descents.
+      BST_COMPARE_NUMBERS compares any arithmetic type
+
+    - Each key is stored once, inserting a key that is already in the bst replaces its value
+
+    - A name##Node stays valid, and keeps its key and value, until its key is removed
+
+    - The functions are static inline, DEFINE_BST can be used in several translation units,
+      each one gets its own copy of the functions the compiler doesn't inline
+
+    - Nodes are allocated from a node pool owned by the bst (see pool.h), bsts made by split##name
+      share the pool of the bst they come from
+
+    - Parameter checks are compiled out when DS_NO_CHECKS is defined (see Common/error.h)
+
+    - In this module its assumed name * != NULL and name##Node * != NULL for functions that recieve
+      those as parameters
+
+    - It's necessary to free the memory allocated for the bsts using the functions generated by DEFINE_BST
+
+    - Generated functions:
+        - name *new##name(): Returns a pointer to a new empty bst
+
+        - bool is##name##Empty(name *tree): Returns true if tree is empty
+
+        - int get##name##Size(name *tree): Returns the number of keys stored in tree
+
+        - int get##name##Height(name *tree): Returns the height of tree, -1 if it is empty
+
+        - name##Node *insert##name(name *tree, K key, V value): Inserts key with value in tree, or replaces
+          the value of key if it is already in tree. Returns the node of key, NULL if key could not be inserted
+
+        - bool remove##name##Node(name *tree, name##Node *node, V *value): Removes node from tree and stores
+          its value in value. value can be NULL
+
+        - bool remove##name(name *tree, K key, V *value): Same as remove##name##Node with the node of key,
+          returns false if key is not in tree
+
+        - name##Node *find##name##Node(name *tree, K key): Returns the node of key, NULL if key is not in tree
+
+        - V *find##name(name *tree, K key): Returns a pointer to the value of key inside tree,
+          NULL if key is not in tree
+
+        - name##Node *lowerBound##name(name *tree, K key): Returns the node with the smallest key >= key,
+          NULL if there is none
+
+        - name##Node *upperBound##name(name *tree, K key): Same as lowerBound##name, with the smallest key > key
+
+        - name##Node *iter##name##Begin(name *tree): Returns the node with the smallest key, NULL if tree is empty
+
+        - name##Node *get##name##NodeSuccessor(name##Node *node): Returns the node with the next key,
+          NULL if node has the largest key. Amortized O(1) when walking the whole bst
+
+        - name##Node *get##name##NodePredecessor(name##Node *node): Same as get##name##NodeSuccessor,
+          with the previous key
+
+        - void range##name(name *tree, K lo, K hi, Visit##name visit, void *extra): Visits in-order the nodes
+          with lo <= key < hi, in O(log n + number of nodes visited)
+
+        - name##Node *select##name(name *tree, int k): Returns the node with the k-th smallest key,
+          starting at 0, in O(log n). NULL if k is outside [0, size)
+
+        - int rank##name(name *tree, K key): Returns the number of keys < key, in O(log n)
+
+        - void inOrder##name##Traversal(name *tree, Visit##name visit, void *extra): Traverse tree in-order
+
+        - bool join##name(name *tree, name *other): Moves every node of other, whose keys must all be larger
+          than the keys of tree, to tree in O(log n + difference of heights), the largest node of tree is
+          detached first to link them. other is left empty. Returns false, and changes nothing, if the keys
+          are not in order or memory could not be allocated
+
+        - bool split##name(name *tree, K key, name **left, name **right): Moves the nodes with keys < key
+          to a new bst stored in left and the rest to a new bst stored in right, in O(log n). tree is left
+          empty. Returns false, and changes nothing, if memory could not be allocated
+
+        - void destroy##name(name *tree): Free all the memory used by tree
+
+    - Visit##name is called with tree and a node, if it returns true the traversal stops.
+      It must not change tree
+
+    - Ex:
+        DEFINE_BST(Prices, int64_t, double, BST_COMPARE_NUMBERS)
+
+        Prices *prices = newPrices();
+        insertPrices(prices, 42, 9.99);
+        double *price = findPrices(prices, 42);
+        destroyPrices(prices);
+*/
+
+#include <stdbool.h>
+#include <stdlib.h>
+
+#include "../Pool/pool.h"
+#include "../Common/error.h"
+
+// compare for DEFINE_BST with keys of any arithmetic type
+#define BST_COMPARE_NUMBERS(a, b) (((a) > (b)) - ((a) < (b)))
+
+#define DEFINE_BST(name, K, V, compare)                                                                 \
+                                                                                                        \
+typedef struct name##Node {                                                                             \
+    /* The fields read by a lookup come first, in the same cache line */                                \
+    K key;                                                                                              \
+    struct name##Node *child[2];                                                                        \
+    struct name##Node *parent;                                                                          \
+    V value;                                                                                            \
+    int height, size;                                                                                   \
+}name##Node;                                                                                            \
+                                                                                                        \
+typedef struct {                                                                                        \
+    name##Node *root;                                                                                   \
+    Pool pool;                                                                                          \
+}name;                                                                                                  \
+                                                                                                        \
+typedef bool (* Visit##name)(name *tree, name##Node *node, void *extra);                                \
+                                                                                                        \
+static inline name *new##name##Tree(Pool pool) {                                                        \
+    name *tree = (name *) malloc(sizeof(name));                                                         \
+    if(!tree) {                                                                                         \
+        reportError("ERROR: Could not allocate memory for new bst -- new" #name " --\n");               \
+        return NULL;                                                                                    \
+    }                                                                                                   \
+                                                                                                        \
+    tree->pool = (pool) ? sharePool(pool) : newPool(sizeof(name##Node), NULL, NULL, NULL);              \
+    if(!tree->pool) {                                                                                   \
+        reportError("ERROR: Could not allocate memory for new bst -- new" #name " --\n");               \
+        free(tree);                                                                                     \
+        return NULL;                                                                                    \
+    }                                                                                                   \
+                                                                                                        \
+    tree->root = NULL;                                                                                  \
+                                                                                                        \
+    return tree;                                                                                        \
+}                                                                                                       \
+                                                                                                        \
+static inline name *new##name() {                                                                       \
+    return new##name##Tree(NULL);                                                                       \
+}                                                                                                       \
+                                                                                                        \
+static inline int get##name##NodeHeight(name##Node *node) {                                             \
+    return (node) ? node->height : -1;                                                                  \
+}                                                                                                       \
+                                                                                                        \
+static inline int get##name##NodeSize(name##Node *node) {                                               \
+    return (node) ? node->size : 0;                                                                     \
+}                                                                                                       \
+                                                                                                        \
+static inline bool is##name##Empty(name *tree) {                                                        \
+    if(PARAMETER_CHECK(!tree)) {                                                                        \
+        reportError("WARNING: Invalid parameter -- is" #name "Empty --\n");                             \
+        return true;                                                                                    \
+    }                                                                                                   \
+                                                                                                        \
+    return tree->root == NULL;                                                                          \
+}                                                                                                       \
+                                                                                                        \
+static inline int get##name##Size(name *tree) {                                                         \
+    if(PARAMETER_CHECK(!tree)) {                                                                        \
+        reportError("WARNING: Invalid parameter -- get" #name "Size --\n");                             \
+        return 0;                                                                                       \
+    }                                                                                                   \
+                                                                                                        \
+    return get##name##NodeSize(tree->root);                                                             \
+}                                                                                                       \
+                                                                                                        \
+static inline int get##name##Height(name *tree) {                                                       \
+    if(PARAMETER_CHECK(!tree)) {                                                                        \
+        reportError("WARNING: Invalid parameter -- get" #name "Height --\n");                           \
+        return -1;                                                                                      \
+    }                                                                                                   \
+                                                                                                        \
+    return get##name##NodeHeight(tree->root);                                                           \
+}                                                                                                       \
+                                                                                                        \
+static inline void update##name##Node(name##Node *node) {                                               \
+    int left = get##name##NodeHeight(node->child[0]);                                                   \
+    int right = get##name##NodeHeight(node->child[1]);                                                  \
+                                                                                                        \
+    node->height = 1 + ((left > right) ? left : right);                                                 \
+    node->size = get##name##NodeSize(node->child[0]) + get##name##NodeSize(node->child[1]) + 1;         \
+}                                                                                                       \
+                                                                                                        \
+/* Links newChild to parent in the position occupied by oldChild */                                     \
+static inline void replace##name##Child(name *tree, name##Node *parent, name##Node *oldChild,           \
+                                         name##Node *newChild) {                                        \
+    if(!parent) tree->root = newChild;                                                                  \
+    else parent->child[parent->child[1] == oldChild] = newChild;                                        \
+                                                                                                        \
+    if(newChild) newChild->parent = parent;                                                             \
+}                                                                                                       \
+                                                                                                        \
+/* side is 0 to rotate left, 1 to rotate right, returns the new root of the subtree */                  \
+static inline name##Node *rotate##name(name *tree, name##Node *node, int side) {                        \
+    name##Node *pivot = node->child[!side];                                                             \
+                                                                                                        \
+    node->child[!side] = pivot->child[side];                                                            \
+    if(pivot->child[side]) pivot->child[side]->parent = node;                                           \
+                                                                                                        \
+    replace##name##Child(tree, node->parent, node, pivot);                                              \
+                                                                                                        \
+    pivot->child[side] = node;                                                                          \
+    node->parent = pivot;                                                                               \
+                                                                                                        \
+    update##name##Node(node);                                                                           \
+    update##name##Node(pivot);                                                                          \
+                                                                                                        \
+    return pivot;                                                                                       \
+}                                                                                                       \
+                                                                                                        \
+/* Walks from node up to the root updating heights and sizes and rotating unbalanced nodes */           \
+static inline void rebalance##name(name *tree, name##Node *node) {                                      \
+    while(node) {                                                                                       \
+        update##name##Node(node);                                                                       \
+                                                                                                        \
+        int balance = get##name##NodeHeight(node->child[0]) - get##name##NodeHeight(node->child[1]);    \
+        if(balance > 1 || balance < -1) {                                                               \
+            /* The taller side, and the side of its child that must not be the taller one */            \
+            int side = balance < -1;                                                                    \
+            name##Node *child = node->child[side];                                                      \
+                                                                                                        \
+            if(get##name##NodeHeight(child->child[side]) < get##name##NodeHeight(child->child[!side]))  \
+                rotate##name(tree, child, side);                                                        \
+                                                                                                        \
+            node = rotate##name(tree, node, !side);                                                     \
+        }                                                                                               \
+                                                                                                        \
+        node = node->parent;                                                                            \
+    }                                                                                                   \
+}                                                                                                       \
+                                                                                                        \
+static inline name##Node *get##name##Smallest(name##Node *root) {                                       \
+    while(root->child[0]) root = root->child[0];                                                        \
+                                                                                                        \
+    return root;                                                                                        \
+}                                                                                                       \
+                                                                                                        \
+static inline name##Node *insert##name(name *tree, K key, V value) {                                    \
+    if(PARAMETER_CHECK(!tree)) {                                                                        \
+        reportError("WARNING: Invalid parameter -- insert" #name " --\n");                              \
+        return NULL;                                                                                    \
+    }                                                                                                   \
+                                                                                                        \
+    name##Node *parent = NULL;                                                                          \
+    int side = 0;                                                                                       \
+                                                                                                        \
+    for(name##Node *node = tree->root; node; node = node->child[side]) {                                \
+        int cmp = compare(key, node->key);                                                              \
+        if(cmp == 0) {                                                                                  \
+            node->value = value;                                                                        \
+            return node;                                                                                \
+        }                                                                                               \
+                                                                                                        \
+        parent = node;                                                                                  \
+        side = cmp > 0;                                                                                 \
+    }                                                                                                   \
+                                                                                                        \
+    name##Node *node = (name##Node *) allocatePool(tree->pool);                                         \
+    if(!node) {                                                                                         \
+        reportError("ERROR: Could not allocate memory for new bst node -- insert" #name " --\n");       \
+        return NULL;                                                                                    \
+    }                                                                                                   \
+                                                                                                        \
+    node->key = key;                                                                                    \
+    node->child[0] = NULL;                                                                              \
+    node->child[1] = NULL;                                                                              \
+    node->parent = parent;                                                                              \
+    node->value = value;                                                                                \
+    node->height = 0;                                                                                   \
+    node->size = 1;                                                                                     \
+                                                                                                        \
+    if(parent) parent->child[side] = node;                                                              \
+    else tree->root = node;                                                                             \
+                                                                                                        \
+    rebalance##name(tree, parent);                                                                      \
+                                                                                                        \
+    return node;                                                                                        \
+}                                                                                                       \
+                                                                                                        \
+static inline bool remove##name##Node(name *tree, name##Node *node, V *value) {                         \
+    if(PARAMETER_CHECK(!tree || !node)) {                                                               \
+        reportError("WARNING: Invalid parameters -- remove" #name "Node --\n");                         \
+        return false;                                                                                   \
+    }                                                                                                   \
+                                                                                                        \
+    /* Lowest node whose subtree changes */                                                             \
+    name##Node *changed;                                                                                \
+                                                                                                        \
+    if(node->child[0] && node->child[1]) {                                                              \
+        /* Relink the in-order successor in place of node, so handles to it stay valid */               \
+        name##Node *successor = get##name##Smallest(node->child[1]);                                    \
+                                                                                                        \
+        if(successor->parent != node) {                                                                 \
+            changed = successor->parent;                                                                \
+                                                                                                        \
+            replace##name##Child(tree, successor->parent, successor, successor->child[1]);              \
+                                                                                                        \
+            successor->child[1] = node->child[1];                                                       \
+            successor->child[1]->parent = successor;                                                    \
+        }                                                                                               \
+        else changed = successor;                                                                       \
+                                                                                                        \
+        replace##name##Child(tree, node->parent, node, successor);                                      \
+                                                                                                        \
+        successor->child[0] = node->child[0];                                                           \
+        successor->child[0]->parent = successor;                                                        \
+    }                                                                                                   \
+    else {                                                                                              \
+        changed = node->parent;                                                                         \
+                                                                                                        \
+        replace##name##Child(tree, node->parent, node, node->child[node->child[0] == NULL]);            \
+    }                                                                                                   \
+                                                                                                        \
+    rebalance##name(tree, changed);                                                                     \
+                                                                                                        \
+    if(value) *value = node->value;                                                                     \
+    freePool(tree->pool, node);                                                                         \
+                                                                                                        \
+    return true;                                                                                        \
+}                                                                                                       \
+                                                                                                        \
+static inline name##Node *find##name##Node(name *tree, K key) {                                         \
+    if(PARAMETER_CHECK(!tree)) {                                                                        \
+        reportError("WARNING: Invalid parameter -- find" #name "Node --\n");                            \
+        return NULL;                                                                                    \
+    }                                                                                                   \
+                                                                                                        \
+    name##Node *node = tree->root;                                                                      \
+    while(node) {                                                                                       \
+        int cmp = compare(key, node->key);                                                              \
+        if(cmp == 0) return node;                                                                       \
+                                                                                                        \
+        node = node->child[cmp > 0];                                                                    \
+    }                                                                                                   \
+                                                                                                        \
+    return NULL;                                                                                        \
+}                                                                                                       \
+                                                                                                        \
+static inline V *find##name(name *tree, K key) {                                                        \
+    name##Node *node = find##name##Node(tree, key);                                                     \
+                                                                                                        \
+    return (node) ? &node->value : NULL;                                                                \
+}                                                                                                       \
+                                                                                                        \
+static inline bool remove##name(name *tree, K key, V *value) {                                          \
+    name##Node *node = find##name##Node(tree, key);                                                     \
+    if(!node) return false;                                                                             \
+                                                                                                        \
+    return remove##name##Node(tree, node, value);                                                       \
+}                                                                                                       \
+                                                                                                        \
+/* Returns the node with the smallest key >= key, or > key if strict */                                 \
+static inline name##Node *find##name##Bound(name *tree, K key, bool strict) {                           \
+    name##Node *bound = NULL;                                                                           \
+    name##Node *node = tree->root;                                                                      \
+                                                                                                        \
+    while(node) {                                                                                       \
+        int cmp = compare(node->key, key);                                                              \
+        bool right = cmp < 0 || (strict && cmp == 0);                                                   \
+                                                                                                        \
+        if(!right) bound = node;                                                                        \
+        node = node->child[right];                                                                      \
+    }                                                                                                   \
+                                                                                                        \
+    return bound;                                                                                       \
+}                                                                                                       \
+                                                                                                        \
+static inline name##Node *lowerBound##name(name *tree, K key) {                                         \
+    if(PARAMETER_CHECK(!tree)) {                                                                        \
+        reportError("WARNING: Invalid parameter -- lowerBound" #name " --\n");                          \
+        return NULL;                                                                                    \
+    }                                                                                                   \
+                                                                                                        \
+    return find##name##Bound(tree, key, false);                                                         \
+}                                                                                                       \
+                                                                                                        \
+static inline name##Node *upperBound##name(name *tree, K key) {                                         \
+    if(PARAMETER_CHECK(!tree)) {                                                                        \
+        reportError("WARNING: Invalid parameter -- upperBound" #name " --\n");                          \
+        return NULL;                                                                                    \
+    }                                                                                                   \
+                                                                                                        \
+    return find##name##Bound(tree, key, true);                                                          \
+}                                                                                                       \
+                                                                                                        \
+static inline name##Node *iter##name##Begin(name *tree) {                                               \
+    if(PARAMETER_CHECK(!tree)) {                                                                        \
+        reportError("WARNING: Invalid parameter -- iter" #name "Begin --\n");                           \
+        return NULL;                                                                                    \
+    }                                                                                                   \
+                                                                                                        \
+    return (tree->root) ? get##name##Smallest(tree->root) : NULL;                                       \
+}                                                                                                       \
+                                                                                                        \
+static inline name##Node *get##name##NodeSuccessor(name##Node *node) {                                  \
+    if(node->child[1]) return get##name##Smallest(node->child[1]);                                      \
+                                                                                                        \
+    while(node->parent && node->parent->child[1] == node) node = node->parent;                          \
+                                                                                                        \
+    return node->parent;                                                                                \
+}                                                                                                       \
+                                                                                                        \
+static inline name##Node *get##name##NodePredecessor(name##Node *node) {                                \
+    if(node->child[0]) {                                                                                \
+        for(node = node->child[0]; node->child[1]; node = node->child[1]);                              \
+        return node;                                                                                    \
+    }                                                                                                   \
+                                                                                                        \
+    while(node->parent && node->parent->child[0] == node) node = node->parent;                          \
+                                                                                                        \
+    return node->parent;                                                                                \
+}                                                                                                       \
+                                                                                                        \
+static inline void range##name(name *tree, K lo, K hi, Visit##name visit, void *extra) {                \
+    if(PARAMETER_CHECK(!tree)) {                                                                        \
+        reportError("WARNING: Invalid parameter -- range" #name " --\n");                               \
+        return;                                                                                         \
+    }                                                                                                   \
+                                                                                                        \
+    name##Node *node = find##name##Bound(tree, lo, false);                                              \
+                                                                                                        \
+    for(; node && compare(node->key, hi) < 0; node = get##name##NodeSuccessor(node)) {                  \
+        if(visit && visit(tree, node, extra)) return;                                                   \
+    }                                                                                                   \
+}                                                                                                       \
+                                                                                                        \
+static inline name##Node *select##name(name *tree, int k) {                                             \
+    if(PARAMETER_CHECK(!tree)) {                                                                        \
+        reportError("WARNING: Invalid parameter -- select" #name " --\n");                              \
+        return NULL;                                                                                    \
+    }                                                                                                   \
+                                                                                                        \
+    name##Node *node = tree->root;                                                                      \
+    if(k < 0 || k >= get##name##NodeSize(node)) return NULL;                                            \
+                                                                                                        \
+    while(node) {                                                                                       \
+        int leftSize = get##name##NodeSize(node->child[0]);                                             \
+                                                                                                        \
+        if(k == leftSize) break;                                                                        \
+                                                                                                        \
+        if(k < leftSize) node = node->child[0];                                                         \
+        else {                                                                                          \
+            k -= leftSize + 1;                                                                          \
+            node = node->child[1];                                                                      \
+        }                                                                                               \
+    }                                                                                                   \
+                                                                                                        \
+    return node;                                                                                        \
+}                                                                                                       \
+                                                                                                        \
+static inline int rank##name(name *tree, K key) {                                                       \
+    if(PARAMETER_CHECK(!tree)) {                                                                        \
+        reportError("WARNING: Invalid parameter -- rank" #name " --\n");                                \
+        return 0;                                                                                       \
+    }                                                                                                   \
+                                                                                                        \
+    name##Node *node = tree->root;                                                                      \
+    int rank = 0;                                                                                       \
+                                                                                                        \
+    while(node) {                                                                                       \
+        if(compare(node->key, key) < 0) {                                                               \
+            rank += get##name##NodeSize(node->child[0]) + 1;                                            \
+            node = node->child[1];                                                                      \
+        }                                                                                               \
+        else node = node->child[0];                                                                     \
+    }                                                                                                   \
+                                                                                                        \
+    return rank;                                                                                        \
+}                                                                                                       \
+                                                                                                        \
+static inline void inOrder##name##Traversal(name *tree, Visit##name visit, void *extra) {               \
+    if(PARAMETER_CHECK(!tree)) {                                                                        \
+        reportError("WARNING: Invalid parameter -- inOrder" #name "Traversal --\n");                    \
+        return;                                                                                         \
+    }                                                                                                   \
+                                                                                                        \
+    if(!tree->root || !visit) return;                                                                   \
+                                                                                                        \
+    name##Node *node = get##name##Smallest(tree->root);                                                 \
+                                                                                                        \
+    for(; node; node = get##name##NodeSuccessor(node)) {                                                \
+        if(visit(tree, node, extra)) return;                                                            \
+    }                                                                                                   \
+}                                                                                                       \
+                                                                                                        \
+/* Detaches node from its children, which become subtrees without parent */                             \
+static inline void expose##name##Node(name##Node *node, name##Node **left, name##Node **right) {        \
+    *left = node->child[0];                                                                             \
+    *right = node->child[1];                                                                            \
+                                                                                                        \
+    if(*left) (*left)->parent = NULL;                                                                   \
+    if(*right) (*right)->parent = NULL;                                                                 \
+                                                                                                        \
+    node->child[0] = NULL;                                                                              \
+    node->child[1] = NULL;                                                                              \
+    node->parent = NULL;                                                                                \
+}                                                                                                       \
+                                                                                                        \
+/*                                                                                                      \
+    Returns the root of a subtree with the nodes of left, then middle, then the nodes of right,         \
+    placing middle on the spine of the taller subtree where the heights match. Rotations at the         \
+    top of the subtree change tree->root, the callers set it afterwards                                 \
+*/                                                                                                      \
+static inline name##Node *join##name##Nodes(name *tree, name##Node *left, name##Node *middle,           \
+                                            name##Node *right) {                                        \
+    int leftHeight = get##name##NodeHeight(left);                                                       \
+    int rightHeight = get##name##NodeHeight(right);                                                     \
+                                                                                                        \
+    name##Node *parent = NULL;                                                                          \
+                                                                                                        \
+    middle->child[0] = left;                                                                            \
+    middle->child[1] = right;                                                                           \
+                                                                                                        \
+    /* side is the side of middle the taller subtree ends on */                                         \
+    int side = rightHeight > leftHeight;                                                                \
+    int shorter = (side) ? leftHeight : rightHeight;                                                    \
+                                                                                                        \
+    if(leftHeight > rightHeight + 1 || rightHeight > leftHeight + 1) {                                  \
+        for(parent = middle->child[side]; get##name##NodeHeight(parent->child[!side]) > shorter + 1;    \
+            parent = parent->child[!side]);                                                             \
+                                                                                                        \
+        middle->child[side] = parent->child[!side];                                                     \
+        parent->child[!side] = middle;                                                                  \
+    }                                                                                                   \
+                                                                                                        \
+    middle->parent = parent;                                                                            \
+    if(middle->child[0]) middle->child[0]->parent = middle;                                             \
+    if(middle->child[1]) middle->child[1]->parent = middle;                                             \
+                                                                                                        \
+    update##name##Node(middle);                                                                         \
+    if(!parent) return middle;                                                                          \
+                                                                                                        \
+    rebalance##name(tree, parent);                                                                      \
+                                                                                                        \
+    /* The path from middle to the top is as long as the descent */                                     \
+    name##Node *root;                                                                                   \
+    for(root = middle; root->parent; root = root->parent);                                              \
+                                                                                                        \
+    return root;                                                                                        \
+}                                                                                                       \
+                                                                                                        \
+/* Detaches the node with the largest key of the subtree rooted at root into last */                    \
+static inline name##Node *split##name##Last(name *tree, name##Node *root, name##Node **last) {          \
+    name##Node *left, *right;                                                                           \
+    expose##name##Node(root, &left, &right);                                                            \
+                                                                                                        \
+    if(!right) {                                                                                        \
+        *last = root;                                                                                   \
+        return left;                                                                                    \
+    }                                                                                                   \
+                                                                                                        \
+    name##Node *rest = split##name##Last(tree, right, last);                                            \
+                                                                                                        \
+    return join##name##Nodes(tree, left, root, rest);                                                   \
+}                                                                                                       \
+                                                                                                        \
+/* Splits the subtree rooted at root, returns the keys < key and stores the keys >= key in right */     \
+static inline name##Node *split##name##Nodes(name *tree, name##Node *root, K key, name##Node **right) { \
+    if(!root) {                                                                                         \
+        *right = NULL;                                                                                  \
+        return NULL;                                                                                    \
+    }                                                                                                   \
+                                                                                                        \
+    name##Node *leftChild, *rightChild;                                                                 \
+    expose##name##Node(root, &leftChild, &rightChild);                                                  \
+                                                                                                        \
+    if(compare(key, root->key) <= 0) {                                                                  \
+        name##Node *middle;                                                                             \
+        name##Node *left = split##name##Nodes(tree, leftChild, key, &middle);                           \
+                                                                                                        \
+        *right = join##name##Nodes(tree, middle, root, rightChild);                                     \
+                                                                                                        \
+        return left;                                                                                    \
+    }                                                                                                   \
+                                                                                                        \
+    name##Node *middle = split##name##Nodes(tree, rightChild, key, right);                              \
+                                                                                                        \
+    return join##name##Nodes(tree, leftChild, root, middle);                                            \
+}                                                                                                       \
+                                                                                                        \
+/* Returns every node of the subtree rooted at root to pool, children before their parent */            \
+static inline void free##name##Nodes(Pool pool, name##Node *root) {                                     \
+    name##Node *node = root;                                                                            \
+                                                                                                        \
+    while(node) {                                                                                       \
+        if(node->child[0]) node = node->child[0];                                                       \
+        else if(node->child[1]) node = node->child[1];                                                  \
+        else {                                                                                          \
+            name##Node *parent = node->parent;                                                          \
+                                                                                                        \
+            if(parent) parent->child[parent->child[1] == node] = NULL;                                  \
+            if(node == root) parent = NULL;                                                             \
+                                                                                                        \
+            freePool(pool, node);                                                                       \
+            node = parent;                                                                              \
+        }                                                                                               \
+    }                                                                                                   \
+}                                                                                                       \
+                                                                                                        \
+/* Returns a copy of the subtree rooted at node allocated from the pool of tree, NULL on failure */     \
+static inline name##Node *copy##name##Nodes(name *tree, name##Node *node, bool *failed) {               \
+    if(!node || *failed) return NULL;                                                                   \
+                                                                                                        \
+    name##Node *copy = (name##Node *) allocatePool(tree->pool);                                         \
+    if(!copy) {                                                                                         \
+        *failed = true;                                                                                 \
+        return NULL;                                                                                    \
+    }                                                                                                   \
+                                                                                                        \
+    *copy = *node;                                                                                      \
+    copy->parent = NULL;                                                                                \
+                                                                                                        \
+    copy->child[0] = copy##name##Nodes(tree, node->child[0], failed);                                   \
+    if(copy->child[0]) copy->child[0]->parent = copy;                                                   \
+                                                                                                        \
+    copy->child[1] = copy##name##Nodes(tree, node->child[1], failed);                                   \
+    if(copy->child[1]) copy->child[1]->parent = copy;                                                   \
+                                                                                                        \
+    return copy;                                                                                        \
+}                                                                                                       \
+                                                                                                        \
+static inline bool join##name(name *tree, name *other) {                                                \
+    if(PARAMETER_CHECK(!tree || !other || tree == other)) {                                             \
+        reportError("WARNING: Invalid parameters -- join" #name " --\n");                               \
+        return false;                                                                                   \
+    }                                                                                                   \
+                                                                                                        \
+    if(!other->root) return true;                                                                       \
+                                                                                                        \
+    if(tree->root) {                                                                                    \
+        name##Node *largest;                                                                            \
+        for(largest = tree->root; largest->child[1]; largest = largest->child[1]);                      \
+                                                                                                        \
+        if(compare(largest->key, get##name##Smallest(other->root)->key) >= 0) {                         \
+            reportError("WARNING: Keys of other are not after the keys of tree -- join" #name " --\n"); \
+            return false;                                                                               \
+        }                                                                                               \
+    }                                                                                                   \
+                                                                                                        \
+    /* The nodes of other move to the pool of tree, or are copied to it if the pools can't be merged */ \
+    if(tree->pool != other->pool && !mergePool(tree->pool, other->pool)) {                              \
+        bool failed = false;                                                                            \
+        name##Node *copy = copy##name##Nodes(tree, other->root, &failed);                               \
+                                                                                                        \
+        if(failed) {                                                                                    \
+            reportError("ERROR: Could not allocate memory for bst nodes -- join" #name " --\n");        \
+            free##name##Nodes(tree->pool, copy);                                                        \
+            return false;                                                                               \
+        }                                                                                               \
+                                                                                                        \
+        free##name##Nodes(other->pool, other->root);                                                    \
+        other->root = copy;                                                                             \
+    }                                                                                                   \
+                                                                                                        \
+    name##Node *left = tree->root, *right = other->root;                                                \
+    other->root = NULL;                                                                                 \
+                                                                                                        \
+    if(!left) {                                                                                         \
+        tree->root = right;                                                                             \
+        return true;                                                                                    \
+    }                                                                                                   \
+                                                                                                        \
+    name##Node *last;                                                                                   \
+    left = split##name##Last(tree, left, &last);                                                        \
+                                                                                                        \
+    tree->root = join##name##Nodes(tree, left, last, right);                                            \
+                                                                                                        \
+    return true;                                                                                        \
+}                                                                                                       \
+                                                                                                        \
+static inline void destroy##name(name *tree) {                                                          \
+    if(!tree) return;                                                                                   \
+                                                                                                        \
+    /* Nodes are dropped with the slabs of the pool instead of one by one,                              \
+       unless other bsts still use the pool */                                                          \
+    if(isPoolShared(tree->pool)) free##name##Nodes(tree->pool, tree->root);                             \
+                                                                                                        \
+    destroyPool(tree->pool);                                                                            \
+                                                                                                        \
+    free(tree);                                                                                         \
+}                                                                                                       \
+                                                                                                        \
+static inline bool split##name(name *tree, K key, name **left, name **right) {                          \
+    if(PARAMETER_CHECK(!tree || !left || !right)) {                                                     \
+        reportError("WARNING: Invalid parameters -- split" #name " --\n");                              \
+        return false;                                                                                   \
+    }                                                                                                   \
+                                                                                                        \
+    name *leftTree = new##name##Tree(tree->pool);                                                       \
+    name *rightTree = new##name##Tree(tree->pool);                                                      \
+    if(!leftTree || !rightTree) {                                                                       \
+        destroy##name(leftTree);                                                                        \
+        destroy##name(rightTree);                                                                       \
+        return false;                                                                                   \
+    }                                                                                                   \
+                                                                                                        \
+    name##Node *rightRoot;                                                                              \
+    leftTree->root = split##name##Nodes(tree, tree->root, key, &rightRoot);                             \
+    rightTree->root = rightRoot;                                                                        \
+    tree->root = NULL;                                                                                  \
+                                                                                                        \
+    *left = leftTree;                                                                                   \
+    *right = rightTree;                                                                                 \
+                                                                                                        \
+    return true;                                                                                        \
+}
+
+#endif
@@ -0,0 +1,83 @@
+#ifndef BST_INLINE_H
+#define BST_INLINE_H
+
+/*
+    - Memory layout of the BST module and inline versions of its trivial accessors
+
+    - bst.h includes this header when DS_NO_CHECKS is defined, the accessors are then replaced
+      by the inline versions, which don't check their parameters and can be inlined in the
+      caller's loops
+
+    - bst.c wraps the names of the replaced accessors in parentheses, so their out of line
+      definitions are still compiled
+*/
+
+#include "bst.h"
+
+typedef struct bstnode {
+    int height, size;
+    struct bstnode *parent, *leftChild, *rightChild;
+    BSTElement element;
+} BSTNODE;
+
+/*
+    - Eytzinger layout of a frozen BST: slot 1 holds the root and the children of slot i
+      are slots 2i and 2i + 1, slot 0 is unused
+*/
+typedef struct {
+    int size;
+    BSTElement *elements;
+    BSTNODE **nodes;
+}BSTFROZEN;
+
+typedef struct {
+    CompareElementsBST compare;
+    bool balanced;
+    BSTNODE *root;
+    Pool pool;
+
+    // Search layout built by freezeBST, NULL if the BST is not frozen
+    BSTFROZEN *frozen;
+}BSTTREE;
+
+static inline int getBSTHeightInline(BSTNode root) {
+    return (root) ? ((BSTNODE *) root)->height : -1;
+}
+
+static inline int getBSTSizeInline(BST bst) {
+    BSTNODE *root = ((BSTTREE *) bst)->root;
+
+    return (root) ? root->size : 0;
+}
+
+static inline BSTNode getBSTRootInline(BST bst) {
+    return ((BSTTREE *) bst)->root;
+}
+
+static inline BSTNode getBSTNodeLeftNodeInline(BSTNode node) {
+    return ((BSTNODE *) node)->leftChild;
+}
+
+static inline BSTNode getBSTNodeRightNodeInline(BSTNode node) {
+    return ((BSTNODE *) node)->rightChild;
+}
+
+static inline BSTNode getBSTNodeParentNodeInline(BSTNode node) {
+    return ((BSTNODE *) node)->parent;
+}
+
+static inline BSTElement getBSTNodeElementInline(BSTNode node) {
+    return ((BSTNODE *) node)->element;
+}
+
+#ifdef DS_NO_CHECKS
+#define getBSTHeight(root) getBSTHeightInline(root)
+#define getBSTSize(bst) getBSTSizeInline(bst)
+#define getBSTRoot(bst) getBSTRootInline(bst)
+#define getBSTNodeLeftNode(node) getBSTNodeLeftNodeInline(node)
+#define getBSTNodeRightNode(node) getBSTNodeRightNodeInline(node)
+#define getBSTNodeParentNode(node) getBSTNodeParentNodeInline(node)
+#define getBSTNodeElement(node) getBSTNodeElementInline(node)
+#endif
+
+#endif
@@ -0,0 +1,315 @@
+#define _POSIX_C_SOURCE 200809L
+
+// off_t holds offsets past 2 GiB on 32-bit systems too
+#define _FILE_OFFSET_BITS 64
+
+#include <fcntl.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "bst_mmap.h"
+#include "../Common/error.h"
+
+#define BST_MAP_MAGIC "DSBSTMAP"
+#define BST_MAP_VERSION 1
+
+// Element bytes start at multiples of this alignment
+#define BST_MAP_ALIGNMENT 8
+
+#define BST_MAP_ALIGN(size) (((size) + BST_MAP_ALIGNMENT - 1) / BST_MAP_ALIGNMENT * BST_MAP_ALIGNMENT)
+
+typedef struct {
+    char magic[8];
+    uint32_t version, nodeSize;
+    int32_t size, root;
+
+    // Offset of the node array and size of the file, in bytes
+    uint64_t nodes, length;
+}BSTMAPHEADER;
+
+typedef struct {
+    // Indexes in the node array, -1 if there is no child
+    int32_t leftChild, rightChild;
+
+    // Offset of the element bytes from the start of the file and their number
+    uint64_t element, elementSize;
+}BSTMAPNODE;
+
+typedef struct {
+    CompareElementsBST compare;
+    char *base;
+    size_t length;
+    const BSTMAPHEADER *header;
+    const BSTMAPNODE *nodes;
+}MAPPEDBST;
+
+/*
+    # Input:
+        - nodes: Node array, in-order
+        - first: Index of the first node of the subtree
+        - count: Number of nodes in the subtree
+
+    # Description:
+        - Links the nodes from first to first + count - 1 as a height-balanced
+          subtree and returns the index of its root, -1 if count is 0
+*/
+int32_t linkBSTMapNodes(BSTMAPNODE *nodes, int32_t first, int32_t count) {
+    if(count <= 0) return -1;
+
+    int32_t root = first + (count - 1) / 2;
+
+    nodes[root].leftChild = linkBSTMapNodes(nodes, first, root - first);
+    nodes[root].rightChild = linkBSTMapNodes(nodes, root + 1, first + count - root - 1);
+
+    return root;
+}
+
+/*
+    # Input:
+        - mapped: MappedBST
+        - node: Node of mapped
+
+    # Description:
+        - Returns true if the element bytes of node are inside the file
+*/
+bool isBSTMapNodeValid(const MAPPEDBST *mapped, const BSTMAPNODE *node) {
+    return node->element <= mapped->length && node->elementSize <= mapped->length - node->element;
+}
+
+bool saveBST(BST bst, const char *path, SerializeBSTElement serialize, void *extra) {
+    if(PARAMETER_CHECK(!bst || !path || !serialize)) {
+        reportError("WARNING: Invalid parameters -- saveBST --\n");
+        return false;
+    }
+
+    int size = getBSTSize(bst);
+
+    BSTMAPNODE *nodes = (BSTMAPNODE *) malloc((size > 0 ? size : 1) * sizeof(BSTMAPNODE));
+    if(!nodes) {
+        reportError("ERROR: Could not allocate memory for BST nodes -- saveBST --\n");
+        return false;
+    }
+
+    FILE *file = fopen(path, "wb");
+    if(!file) {
+        reportError("ERROR: Could not open file -- saveBST --\n");
+        free(nodes);
+        return false;
+    }
+
+    // The element bytes are written after the space of the header and the nodes,
+    // which are written once the offsets are known
+    BSTMAPHEADER header = {BST_MAP_MAGIC, BST_MAP_VERSION, sizeof(BSTMAPNODE), size, -1, sizeof(BSTMAPHEADER), 0};
+    uint64_t offset = sizeof(BSTMAPHEADER) + (uint64_t) size * sizeof(BSTMAPNODE);
+
+    static const char padding[BST_MAP_ALIGNMENT] = {0};
+    bool ok = fseeko(file, (off_t) offset, SEEK_SET) == 0;
+
+    int i = 0;
+    for(BSTNode node = bstIterBegin(bst); ok && node; node = bstIterNext(node), i++) {
+        size_t elementSize;
+        const void *bytes = serialize(getBSTNodeElement(node), &elementSize, extra);
+
+        size_t aligned = BST_MAP_ALIGN(elementSize);
+
+        ok = bytes && fwrite(bytes, 1, elementSize, file) == elementSize &&
+             fwrite(padding, 1, aligned - elementSize, file) == aligned - elementSize;
+
+        nodes[i].element = offset;
+        nodes[i].elementSize = elementSize;
+        offset += aligned;
+    }
+
+    if(ok) {
+        header.root = linkBSTMapNodes(nodes, 0, size);
+        header.length = offset;
+
+        ok = fseeko(file, 0, SEEK_SET) == 0 && fwrite(&header, sizeof(BSTMAPHEADER), 1, file) == 1 &&
+             fwrite(nodes, sizeof(BSTMAPNODE), size, file) == (size_t) size;
+    }
+
+    ok = (fclose(file) == 0) && ok;
+    free(nodes);
+
+    if(!ok) {
+        reportError("ERROR: Could not write file -- saveBST --\n");
+        remove(path);
+    }
+
+    return ok;
+}
+
+MappedBST mmapBST(const char *path, CompareElementsBST compare) {
+    if(PARAMETER_CHECK(!path || !compare)) {
+        reportError("WARNING: Invalid parameters -- mmapBST --\n");
+        return NULL;
+    }
+
+    int fd = open(path, O_RDONLY);
+    if(fd < 0) {
+        reportError("ERROR: Could not open file -- mmapBST --\n");
+        return NULL;
+    }
+
+    struct stat status;
+    if(fstat(fd, &status) != 0 || (uintmax_t) status.st_size > SIZE_MAX || (size_t) status.st_size < sizeof(BSTMAPHEADER)) {
+        reportError("WARNING: Invalid file -- mmapBST --\n");
+        close(fd);
+        return NULL;
+    }
+
+    size_t length = (size_t) status.st_size;
+
+    // The mapping stays valid after the file is closed
+    char *base = (char *) mmap(NULL, length, PROT_READ, MAP_SHARED, fd, 0);
+    close(fd);
+
+    if(base == MAP_FAILED) {
+        reportError("ERROR: Could not map file -- mmapBST --\n");
+        return NULL;
+    }
+
+    const BSTMAPHEADER *header = (const BSTMAPHEADER *) base;
+
+    // The nodes are checked as they are read, a corrupt node can't be followed out of the mapping
+    if(memcmp(header->magic, BST_MAP_MAGIC, sizeof(header->magic)) || header->version != BST_MAP_VERSION ||
+       header->nodeSize != sizeof(BSTMAPNODE) || header->length != length || header->size < 0 ||
+       header->root < -1 || header->root >= header->size || header->nodes != sizeof(BSTMAPHEADER) ||
+       (uint64_t) header->size > (length - sizeof(BSTMAPHEADER)) / sizeof(BSTMAPNODE)) {
+        reportError("WARNING: Invalid file -- mmapBST --\n");
+        munmap(base, length);
+        return NULL;
+    }
+
+    MAPPEDBST *mapped = (MAPPEDBST *) malloc(sizeof(MAPPEDBST));
+    if(!mapped) {
+        reportError("ERROR: Could not allocate memory for new MappedBST -- mmapBST --\n");
+        munmap(base, length);
+        return NULL;
+    }
+
+    mapped->compare = compare;
+    mapped->base = base;
+    mapped->length = length;
+    mapped->header = header;
+    mapped->nodes = (const BSTMAPNODE *) (base + header->nodes);
+
+    return mapped;
+}
+
+int getMappedBSTSize(MappedBST mbst) {
+    if(PARAMETER_CHECK(!mbst)) {
+        reportError("WARNING: Invalid parameter -- getMappedBSTSize --\n");
+        return 0;
+    }
+
+    MAPPEDBST *mapped = (MAPPEDBST *) mbst;
+
+    return mapped->header->size;
+}
+
+BSTElement getMappedBSTElement(MappedBST mbst, int position, size_t *size) {
+    if(PARAMETER_CHECK(!mbst)) {
+        reportError("WARNING: Invalid parameter -- getMappedBSTElement --\n");
+        return NULL;
+    }
+
+    MAPPEDBST *mapped = (MAPPEDBST *) mbst;
+
+    if(position < 0 || position >= mapped->header->size) return NULL;
+
+    const BSTMAPNODE *node = &mapped->nodes[position];
+    if(!isBSTMapNodeValid(mapped, node)) {
+        reportError("WARNING: Invalid node in file -- getMappedBSTElement --\n");
+        return NULL;
+    }
+
+    if(size) *size = node->elementSize;
+
+    return mapped->base + node->element;
+}
+
+int findMappedBST(MappedBST mbst, BSTElement element) {
+    if(PARAMETER_CHECK(!mbst || !element)) {
+        reportError("WARNING: Invalid parameters -- findMappedBST --\n");
+        return -1;
+    }
+
+    MAPPEDBST *mapped = (MAPPEDBST *) mbst;
+
+    // A path visits each node at most once, a longer one means the file links a cycle
+    for(int32_t i = mapped->header->root, steps = 0; i != -1; steps++) {
+        if(i < 0 || i >= mapped->header->size || steps == mapped->header->size || !isBSTMapNodeValid(mapped, &mapped->nodes[i])) {
+            reportError("WARNING: Invalid node in file -- findMappedBST --\n");
+            return -1;
+        }
+
+        int comparison = mapped->compare(element, mapped->base + mapped->nodes[i].element);
+        if(comparison == 0) return i;
+
+        i = (comparison < 0) ? mapped->nodes[i].leftChild : mapped->nodes[i].rightChild;
+    }
+
+    return -1;
+}
+
+int lowerBoundMappedBST(MappedBST mbst, BSTElement element) {
+    if(PARAMETER_CHECK(!mbst || !element)) {
+        reportError("WARNING: Invalid parameters -- lowerBoundMappedBST --\n");
+        return -1;
+    }
+
+    MAPPEDBST *mapped = (MAPPEDBST *) mbst;
+
+    // Nodes are stored in-order, the index of a node is its position
+    int bound = mapped->header->size;
+
+    for(int32_t i = mapped->header->root, steps = 0; i != -1; steps++) {
+        if(i < 0 || i >= mapped->header->size || steps == mapped->header->size || !isBSTMapNodeValid(mapped, &mapped->nodes[i])) {
+            reportError("WARNING: Invalid node in file -- lowerBoundMappedBST --\n");
+            return -1;
+        }
+
+        if(mapped->compare(mapped->base + mapped->nodes[i].element, element) >= 0) {
+            bound = i;
+            i = mapped->nodes[i].leftChild;
+        }
+        else i = mapped->nodes[i].rightChild;
+    }
+
+    return bound;
+}
+
+void traverseMappedBST(MappedBST mbst, VisitMappedBSTElement visit, void *extra) {
+    if(PARAMETER_CHECK(!mbst || !visit)) {
+        reportError("WARNING: Invalid parameters -- traverseMappedBST --\n");
+        return;
+    }
+
+    MAPPEDBST *mapped = (MAPPEDBST *) mbst;
+
+    for(int i = 0; i < mapped->header->size; i++) {
+        if(!isBSTMapNodeValid(mapped, &mapped->nodes[i])) {
+            reportError("WARNING: Invalid node in file -- traverseMappedBST --\n");
+            return;
+        }
+
+        if(visit(mbst, mapped->base + mapped->nodes[i].element, mapped->nodes[i].elementSize, extra)) return;
+    }
+}
+
+void closeMappedBST(MappedBST mbst) {
+    if(!mbst) return;
+
+    MAPPEDBST *mapped = (MAPPEDBST *) mbst;
+
+    munmap(mapped->base, mapped->length);
+    free(mapped);
+
+    mbst = NULL;
+}
@@ -0,0 +1,163 @@
+#ifndef BST_MMAP_H
+#define BST_MMAP_H
+
+/*
+    - This module saves a BST to a file and maps the file back in memory as a read-only
+      MappedBST, so a process can use a tree without rebuilding it
+
+    - The file holds no pointers, it is used as it is once mapped:
+        - A header, then an array with a node for each element, in-order
+        - Nodes link their children by their index in the array, the saved tree is
+          height-balanced whatever the shape of the original BST
+        - Nodes locate their element by its offset from the start of the file, the bytes of
+          each element are aligned to 8 bytes
+
+    - Elements are saved as the bytes given by a SerializeBSTElement function. The elements read
+      from a MappedBST are pointers to those bytes inside the mapping, so elements stored as plain
+      data (numbers, structs without pointers, strings) can be compared and read directly
+
+    - Opening a MappedBST only checks the header, the nodes are read from the file as they are
+      used and the pages are shared with every process that maps the same file. Each node is
+      checked when it is read, functions that reach an invalid node report a warning and stop
+
+    - Files are read by machines with the same byte order and integer sizes as the one that wrote them
+
+    - Each position of a MappedBST is the in-order position of an element, inside the interval [0, size)
+
+    - In this module its assumed MappedBST != NULL and BSTElement != NULL for functions that recieve
+      those as parameters
+
+    - Parameter checks are compiled out when DS_NO_CHECKS is defined (see Common/error.h)
+
+    - It's necessary to close a MappedBST using the functions provided in this module
+*/
+
+#include <stdbool.h>
+#include <stddef.h>
+
+#include "bst.h"
+
+typedef void *MappedBST;
+
+/*
+    - Function utilized by saveBST to get the bytes saved for element
+
+    - Returns a pointer to the bytes and stores their number in size, the bytes
+      must stay valid until the next call. Returns NULL if element can't be saved
+
+    - Ex: For elements pointing to a long, returns element and stores sizeof(long) in size
+*/
+typedef const void *(* SerializeBSTElement)(BSTElement element, size_t *size, void *extra);
+
+/*
+    - Function utilized by traverseMappedBST
+
+    - element points to the size bytes saved for the element
+
+    - If this function returns true, the traversal will stop
+*/
+typedef bool (* VisitMappedBSTElement)(MappedBST mbst, BSTElement element, size_t size, void *extra);
+
+/*
+    # Input:
+        - bst: BST
+        - path: Path of the file, it is replaced if it exists
+        - serialize: Function that gives the bytes saved for each element
+        - extra: Extra pointer given to serialize if necessary
+
+    # Description:
+        - Saves the elements of bst, in-order, to the file at path
+
+        - Returns false if the file could not be written, the file is then removed
+*/
+bool saveBST(BST bst, const char *path, SerializeBSTElement serialize, void *extra);
+
+/*
+    # Input:
+        - path: Path of a file written by saveBST
+        - compare: Function to compare the saved elements
+
+    # Description:
+        - Maps the file at path in memory and returns a pointer to a new MappedBST
+          that reads it, without parsing or copying the nodes
+
+        - compare receives pointers to the saved bytes of the elements and must
+          order them as the BST that was saved
+
+        - Returns NULL if the file could not be mapped or is not a valid file
+*/
+MappedBST mmapBST(const char *path, CompareElementsBST compare);
+
+/*
+    # Input:
+        - mbst: MappedBST
+
+    # Description:
+        - Returns the number of elements stored in mbst
+*/
+int getMappedBSTSize(MappedBST mbst);
+
+/*
+    # Input:
+        - mbst: MappedBST
+        - position: Position of the element
+        - size: Where the size in bytes of the element is stored, can be NULL
+
+    # Description:
+        - Returns the element at position, in O(1)
+
+        - If position is outside [0, size) or the node is invalid, returns NULL
+*/
+BSTElement getMappedBSTElement(MappedBST mbst, int position, size_t *size);
+
+/*
+    # Input:
+        - mbst: MappedBST
+        - element: Searched element, compared with the saved elements by compare
+
+    # Description:
+        - Returns the position of element in mbst, in O(log n)
+
+        - If element is not in mbst or an invalid node is reached, returns -1
+*/
+int findMappedBST(MappedBST mbst, BSTElement element);
+
+/*
+    # Input:
+        - mbst: MappedBST
+        - element: Element to be compared, doesn't need to be in mbst
+
+    # Description:
+        - Returns the position of the smallest element that is >= element, in O(log n)
+
+        - If every element in mbst is < element, returns the size of mbst
+
+        - If the parameters are invalid or an invalid node is reached, returns -1
+*/
+int lowerBoundMappedBST(MappedBST mbst, BSTElement element);
+
+/*
+    # Input:
+        - mbst: MappedBST
+        - visit: Function to be used during the traversal
+        - extra: Extra pointer if necessary
+
+    # Description:
+        - Visits the elements of mbst in-order, reading the nodes sequentially,
+          until an invalid node is reached
+
+        - extra can be NULL
+*/
+void traverseMappedBST(MappedBST mbst, VisitMappedBSTElement visit, void *extra);
+
+/*
+    # Input:
+        - mbst: MappedBST
+
+    # Description:
+        - Unmaps the file and frees the memory used by mbst, the elements
+          read from mbst can't be used afterwards
+*/
+void closeMappedBST(MappedBST mbst);
+
+#endif
@@ -0,0 +1,673 @@
+#include <pthread.h>
+#include <stdatomic.h>
+#include <stdint.h>
+#include <stdlib.h>
+
+#include "cbst.h"
+#include "../Common/error.h"
+
+// Size of a cache line, each reader slot is kept in its own line
+#define CBST_CACHE_LINE 64
+
+// An AVL tree with INT_MAX nodes is less than 45 levels high
+#define CBST_MAX_HEIGHT 64
+
+// Values returned by enterCBSTRead when the reader has no slot of its own
+#define CBST_SHARED_READER -1
+#define CBST_NESTED_READER -2
+
+typedef struct cbstnode {
+    int height;
+    struct cbstnode *leftChild, *rightChild;
+    BSTElement element;
+
+    // Only used by writers: the epoch the node was created in, or retired in
+    // once it is in the retired list, and the link of the retired or spare list
+    unsigned long epoch;
+    struct cbstnode *nextRetired;
+}CBSTNODE;
+
+typedef struct {
+    // Epoch announced by the reader, 0 if it is not reading
+    _Alignas(CBST_CACHE_LINE) atomic_ulong epoch;
+}CBSTSLOT;
+
+typedef struct {
+    // Read by every reader, only changed by writers
+    _Alignas(CBST_CACHE_LINE) CompareElementsBST compare;
+    _Atomic(CBSTNODE *) root;
+    atomic_ulong epoch;
+
+    // Used by writers
+    _Alignas(CBST_CACHE_LINE) pthread_mutex_t writeLock;
+    Pool pool;
+    CBSTNODE *retired;
+    CBSTNODE *spare;
+    int spareCount;
+    atomic_int size;
+
+    // Readers without a slot of their own
+    _Alignas(CBST_CACHE_LINE) atomic_int sharedReaders;
+
+    CBSTSLOT readers[CBST_MAX_THREADS];
+}CBSTTREE;
+
+// Reader slots taken by running threads, the same slot is used by a thread in every cbst
+static atomic_bool cbstSlotUsed[CBST_MAX_THREADS];
+static pthread_key_t cbstSlotKey;
+static pthread_once_t cbstSlotOnce = PTHREAD_ONCE_INIT;
+
+// Slot of the calling thread, -1 if it has not asked for one yet, CBST_MAX_THREADS if none was free
+static _Thread_local int cbstSlot = -1;
+
+/*
+    # Input:
+        - slot: Slot of the exiting thread, plus 1
+
+    # Description:
+        - Returns the slot of a thread when it exits
+*/
+void releaseCBSTThreadSlot(void *slot) {
+    atomic_store(&cbstSlotUsed[(intptr_t) slot - 1], false);
+}
+
+/*
+    # Description:
+        - Creates the key used to be notified when a thread with a slot exits
+*/
+void createCBSTThreadSlotKey() {
+    pthread_key_create(&cbstSlotKey, releaseCBSTThreadSlot);
+}
+
+/*
+    # Description:
+        - Returns the slot of the calling thread, taking a free one
+          the first time it is called by the thread
+
+        - If every slot was taken, returns CBST_MAX_THREADS
+*/
+int getCBSTThreadSlot() {
+    if(cbstSlot >= 0) return cbstSlot;
+
+    pthread_once(&cbstSlotOnce, createCBSTThreadSlotKey);
+
+    cbstSlot = CBST_MAX_THREADS;
+    for(int i = 0; i < CBST_MAX_THREADS; i++) {
+        if(atomic_load_explicit(&cbstSlotUsed[i], memory_order_relaxed) || atomic_exchange(&cbstSlotUsed[i], true)) continue;
+
+        cbstSlot = i;
+        pthread_setspecific(cbstSlotKey, (void *) (intptr_t) (i + 1));
+        break;
+    }
+
+    return cbstSlot;
+}
+
+/*
+    # Input:
+        - tree: cbst to be read
+
+    # Description:
+        - Announces the calling thread is reading tree, nodes it can reach
+          from the root it loads afterwards are not freed until exitCBSTRead
+
+        - Returns the value to be given to exitCBSTRead
+*/
+int enterCBSTRead(CBSTTREE *tree) {
+    int slot = getCBSTThreadSlot();
+
+    if(slot == CBST_MAX_THREADS) {
+        atomic_fetch_add(&tree->sharedReaders, 1);
+        return CBST_SHARED_READER;
+    }
+
+    // A reader inside another read of tree, the epoch of the outer read protects both
+    if(atomic_load_explicit(&tree->readers[slot].epoch, memory_order_relaxed)) return CBST_NESTED_READER;
+
+    // Sequentially consistent so either the writer sees the slot or the reader sees the new root
+    atomic_store(&tree->readers[slot].epoch, atomic_load(&tree->epoch));
+
+    return slot;
+}
+
+/*
+    # Input:
+        - tree: cbst being read
+        - slot: Value returned by enterCBSTRead
+
+    # Description:
+        - Announces the calling thread stopped reading tree
+*/
+void exitCBSTRead(CBSTTREE *tree, int slot) {
+    if(slot == CBST_SHARED_READER) atomic_fetch_sub_explicit(&tree->sharedReaders, 1, memory_order_release);
+    else if(slot != CBST_NESTED_READER) atomic_store_explicit(&tree->readers[slot].epoch, 0, memory_order_release);
+}
+
+CBST newCBST(CompareElementsBST compare) {
+    if(PARAMETER_CHECK(!compare)) {
+        reportError("WARNING: Invalid parameter -- newCBST --\n");
+        return NULL;
+    }
+
+    CBSTTREE *tree = (CBSTTREE *) aligned_alloc(_Alignof(CBSTTREE), sizeof(CBSTTREE));
+    if(!tree) {
+        reportError("ERROR: Could not allocate memory for new cbst -- newCBST --\n");
+        return NULL;
+    }
+
+    // Nodes are only allocated and freed by writers, while holding writeLock
+    tree->pool = newPool(sizeof(CBSTNODE), NULL, NULL, NULL);
+    if(!tree->pool) {
+        reportError("ERROR: Could not allocate memory for new cbst -- newCBST --\n");
+        free(tree);
+        return NULL;
+    }
+
+    tree->compare = compare;
+    atomic_init(&tree->root, NULL);
+    atomic_init(&tree->epoch, 1);
+
+    pthread_mutex_init(&tree->writeLock, NULL);
+    tree->retired = NULL;
+    tree->spare = NULL;
+    tree->spareCount = 0;
+    atomic_init(&tree->size, 0);
+
+    atomic_init(&tree->sharedReaders, 0);
+    for(int i = 0; i < CBST_MAX_THREADS; i++) atomic_init(&tree->readers[i].epoch, 0);
+
+    return tree;
+}
+
+bool isCBSTEmpty(CBST cbst) {
+    if(PARAMETER_CHECK(!cbst)) {
+        reportError("WARNING: Invalid parameter -- isCBSTEmpty --\n");
+        return true;
+    }
+
+    return getCBSTSize(cbst) == 0;
+}
+
+int getCBSTSize(CBST cbst) {
+    if(PARAMETER_CHECK(!cbst)) {
+        reportError("WARNING: Invalid parameter -- getCBSTSize --\n");
+        return 0;
+    }
+
+    CBSTTREE *tree = (CBSTTREE *) cbst;
+
+    return atomic_load_explicit(&tree->size, memory_order_relaxed);
+}
+
+/*
+    # Input:
+        - node: Node from a cbst
+
+    # Description:
+        - Returns the height of the subtree rooted at node, -1 if node is NULL
+*/
+int getCBSTNodeHeight(CBSTNODE *node) {
+    return (node) ? node->height : -1;
+}
+
+/*
+    # Input:
+        - tree: cbst
+
+    # Description:
+        - Returns an uninitialized node from the spare nodes of tree
+
+        - The nodes must have been reserved with reserveCBSTNodes
+*/
+CBSTNODE *takeCBSTSpareNode(CBSTTREE *tree) {
+    CBSTNODE *node = tree->spare;
+
+    tree->spare = node->nextRetired;
+    tree->spareCount--;
+
+    return node;
+}
+
+/*
+    # Input:
+        - tree: cbst
+        - element: Element stored in the node
+
+    # Description:
+        - Returns a new leaf created in the current write
+*/
+CBSTNODE *newCBSTNode(CBSTTREE *tree, BSTElement element) {
+    CBSTNODE *node = takeCBSTSpareNode(tree);
+
+    node->height = 0;
+    node->leftChild = NULL;
+    node->rightChild = NULL;
+    node->element = element;
+    node->epoch = atomic_load_explicit(&tree->epoch, memory_order_relaxed);
+    node->nextRetired = NULL;
+
+    return node;
+}
+
+/*
+    # Input:
+        - tree: cbst
+        - node: Node that is no longer reachable from the new root
+
+    # Description:
+        - Adds node to the retired list of tree, it is freed once
+          no reader can be using it
+*/
+void retireCBSTNode(CBSTTREE *tree, CBSTNODE *node) {
+    node->epoch = atomic_load_explicit(&tree->epoch, memory_order_relaxed);
+    node->nextRetired = tree->retired;
+    tree->retired = node;
+}
+
+/*
+    # Input:
+        - tree: cbst
+        - node: Node from tree
+
+    # Description:
+        - Returns a node that can be modified in the current write: node itself if it
+          was created in this write, otherwise a copy of node, and node is retired
+*/
+CBSTNODE *mutableCBSTNode(CBSTTREE *tree, CBSTNODE *node) {
+    unsigned long epoch = atomic_load_explicit(&tree->epoch, memory_order_relaxed);
+    if(node->epoch == epoch) return node;
+
+    CBSTNODE *copy = takeCBSTSpareNode(tree);
+    *copy = *node;
+    copy->epoch = epoch;
+
+    retireCBSTNode(tree, node);
+
+    return copy;
+}
+
+/*
+    # Input:
+        - tree: cbst
+        - root: Current root of tree
+
+    # Description:
+        - Allocates every node a write may need in the spare nodes of tree,
+          so a write never fails after it has started copying nodes
+
+        - Each level of the path copies at most the node, a child and a grandchild
+          when it is rotated, the nodes not used are kept for the next write
+
+        - Returns false if memory could not be allocated
+*/
+bool reserveCBSTNodes(CBSTTREE *tree, CBSTNODE *root) {
+    int count = 3 * (getCBSTNodeHeight(root) + 2);
+
+    while(tree->spareCount < count) {
+        CBSTNODE *node = (CBSTNODE *) allocatePool(tree->pool);
+        if(!node) {
+            reportError("ERROR: Could not allocate memory for new cbst node -- reserveCBSTNodes --\n");
+            return false;
+        }
+
+        node->nextRetired = tree->spare;
+        tree->spare = node;
+        tree->spareCount++;
+    }
+
+    return true;
+}
+
+/*
+    # Input:
+        - node: Node created in the current write
+
+    # Description:
+        - Recalculates the height of node from its children
+*/
+void updateCBSTNode(CBSTNODE *node) {
+    int left = getCBSTNodeHeight(node->leftChild);
+    int right = getCBSTNodeHeight(node->rightChild);
+
+    node->height = 1 + ((left > right) ? left : right);
+}
+
+/*
+    # Input:
+        - tree: cbst
+        - node: Root of the subtree to be rotated, must have a right child
+
+    # Description:
+        - Rotates the subtree rooted at node to the left and returns its new root,
+          node and its right child are copied if needed
+*/
+CBSTNODE *rotateCBSTLeft(CBSTTREE *tree, CBSTNODE *node) {
+    node = mutableCBSTNode(tree, node);
+    CBSTNODE *pivot = mutableCBSTNode(tree, node->rightChild);
+
+    node->rightChild = pivot->leftChild;
+    pivot->leftChild = node;
+
+    updateCBSTNode(node);
+    updateCBSTNode(pivot);
+
+    return pivot;
+}
+
+/*
+    # Input:
+        - tree: cbst
+        - node: Root of the subtree to be rotated, must have a left child
+
+    # Description:
+        - Rotates the subtree rooted at node to the right and returns its new root,
+          node and its left child are copied if needed
+*/
+CBSTNODE *rotateCBSTRight(CBSTTREE *tree, CBSTNODE *node) {
+    node = mutableCBSTNode(tree, node);
+    CBSTNODE *pivot = mutableCBSTNode(tree, node->leftChild);
+
+    node->leftChild = pivot->rightChild;
+    pivot->rightChild = node;
+
+    updateCBSTNode(node);
+    updateCBSTNode(pivot);
+
+    return pivot;
+}
+
+/*
+    # Input:
+        - tree: cbst
+        - node: Node created in the current write, whose children may be unbalanced by one level
+
+    # Description:
+        - Restores the AVL property of the subtree rooted at node and returns its new root
+*/
+CBSTNODE *rebalanceCBST(CBSTTREE *tree, CBSTNODE *node) {
+    updateCBSTNode(node);
+
+    int balance = getCBSTNodeHeight(node->leftChild) - getCBSTNodeHeight(node->rightChild);
+
+    if(balance > 1) {
+        CBSTNODE *left = node->leftChild;
+        if(getCBSTNodeHeight(left->leftChild) < getCBSTNodeHeight(left->rightChild)) node->leftChild = rotateCBSTLeft(tree, left);
+
+        return rotateCBSTRight(tree, node);
+    }
+
+    if(balance < -1) {
+        CBSTNODE *right = node->rightChild;
+        if(getCBSTNodeHeight(right->rightChild) < getCBSTNodeHeight(right->leftChild)) node->rightChild = rotateCBSTRight(tree, right);
+
+        return rotateCBSTLeft(tree, node);
+    }
+
+    return node;
+}
+
+/*
+    # Input:
+        - tree: cbst
+        - node: Root of a subtree of tree
+        - element: Element to be inserted
+
+    # Description:
+        - Inserts element in the subtree rooted at node, copying the nodes
+          on its path, and returns the new root of the subtree
+*/
+CBSTNODE *insertCBSTNode(CBSTTREE *tree, CBSTNODE *node, BSTElement element) {
+    if(!node) return newCBSTNode(tree, element);
+
+    node = mutableCBSTNode(tree, node);
+
+    if(tree->compare(element, node->element) > 0) node->rightChild = insertCBSTNode(tree, node->rightChild, element);
+    else node->leftChild = insertCBSTNode(tree, node->leftChild, element);
+
+    return rebalanceCBST(tree, node);
+}
+
+/*
+    # Input:
+        - tree: cbst
+        - node: Root of a subtree of tree, must not be NULL
+        - element: Where the smallest element of the subtree is stored
+
+    # Description:
+        - Removes the smallest element from the subtree rooted at node, copying
+          the nodes on its path, and returns the new root of the subtree
+*/
+CBSTNODE *removeCBSTSmallest(CBSTTREE *tree, CBSTNODE *node, BSTElement *element) {
+    if(!node->leftChild) {
+        *element = node->element;
+        retireCBSTNode(tree, node);
+
+        return node->rightChild;
+    }
+
+    node = mutableCBSTNode(tree, node);
+    node->leftChild = removeCBSTSmallest(tree, node->leftChild, element);
+
+    return rebalanceCBST(tree, node);
+}
+
+/*
+    # Input:
+        - tree: cbst
+        - node: Root of a subtree of tree that contains element
+        - element: Element to be removed
+        - removed: Where the removed element is stored
+
+    # Description:
+        - Removes element from the subtree rooted at node, copying the nodes
+          on its path, and returns the new root of the subtree
+*/
+CBSTNODE *removeCBSTNode(CBSTTREE *tree, CBSTNODE *node, BSTElement element, BSTElement *removed) {
+    int cmp = tree->compare(element, node->element);
+
+    if(cmp == 0) {
+        *removed = node->element;
+
+        if(!node->leftChild || !node->rightChild) {
+            retireCBSTNode(tree, node);
+
+            return (node->leftChild) ? node->leftChild : node->rightChild;
+        }
+
+        // The node keeps its place with the element of its successor
+        BSTElement successor;
+        CBSTNODE *right = removeCBSTSmallest(tree, node->rightChild, &successor);
+
+        node = mutableCBSTNode(tree, node);
+        node->element = successor;
+        node->rightChild = right;
+
+        return rebalanceCBST(tree, node);
+    }
+
+    node = mutableCBSTNode(tree, node);
+
+    if(cmp > 0) node->rightChild = removeCBSTNode(tree, node->rightChild, element, removed);
+    else node->leftChild = removeCBSTNode(tree, node->leftChild, element, removed);
+
+    return rebalanceCBST(tree, node);
+}
+
+/*
+    # Input:
+        - tree: cbst
+        - node: Node from tree
+        - element: Searched element
+
+    # Description:
+        - Returns the node in the subtree rooted at node that stores element,
+          if it doesn't exist, returns NULL
+*/
+CBSTNODE *findCBSTNode(CompareElementsBST compare, CBSTNODE *node, BSTElement element) {
+    while(node) {
+        int cmp = compare(element, node->element);
+
+        if(cmp == 0) return node;
+        node = (cmp > 0) ? node->rightChild : node->leftChild;
+    }
+
+    return NULL;
+}
+
+/*
+    # Input:
+        - tree: cbst
+
+    # Description:
+        - Frees the retired nodes of tree that no reader can be using:
+          those retired before the oldest epoch announced by a reader
+*/
+void reclaimCBST(CBSTTREE *tree) {
+    // Readers without a slot don't announce their epoch, nothing is freed while they read
+    if(atomic_load(&tree->sharedReaders)) return;
+
+    unsigned long oldest = atomic_load(&tree->epoch);
+    for(int i = 0; i < CBST_MAX_THREADS; i++) {
+        unsigned long epoch = atomic_load(&tree->readers[i].epoch);
+        if(epoch && epoch < oldest) oldest = epoch;
+    }
+
+    CBSTNODE **link = &tree->retired;
+    while(*link) {
+        CBSTNODE *node = *link;
+
+        if(node->epoch < oldest) {
+            *link = node->nextRetired;
+            freePool(tree->pool, node);
+        }
+        else link = &node->nextRetired;
+    }
+}
+
+/*
+    # Input:
+        - tree: cbst
+        - root: New root of tree, built by the current write
+
+    # Description:
+        - Makes root visible to readers, starts a new epoch and frees the retired
+          nodes that are no longer in use
+
+        - Must be called holding writeLock
+*/
+void publishCBST(CBSTTREE *tree, CBSTNODE *root) {
+    // Sequentially consistent with enterCBSTRead, a reader that is not seen by reclaimCBST
+    // loads the new root
+    atomic_store(&tree->root, root);
+    atomic_fetch_add(&tree->epoch, 1);
+
+    reclaimCBST(tree);
+}
+
+bool insertCBST(CBST cbst, BSTElement element) {
+    if(PARAMETER_CHECK(!cbst || !element)) {
+        reportError("WARNING: Invalid parameters -- insertCBST --\n");
+        return false;
+    }
+
+    CBSTTREE *tree = (CBSTTREE *) cbst;
+
+    pthread_mutex_lock(&tree->writeLock);
+
+    CBSTNODE *root = atomic_load_explicit(&tree->root, memory_order_relaxed);
+    if(!reserveCBSTNodes(tree, root)) {
+        pthread_mutex_unlock(&tree->writeLock);
+        return false;
+    }
+
+    publishCBST(tree, insertCBSTNode(tree, root, element));
+    atomic_fetch_add_explicit(&tree->size, 1, memory_order_relaxed);
+
+    pthread_mutex_unlock(&tree->writeLock);
+
+    return true;
+}
+
+BSTElement removeCBST(CBST cbst, BSTElement element) {
+    if(PARAMETER_CHECK(!cbst || !element)) {
+        reportError("WARNING: Invalid parameters -- removeCBST --\n");
+        return NULL;
+    }
+
+    CBSTTREE *tree = (CBSTTREE *) cbst;
+
+    pthread_mutex_lock(&tree->writeLock);
+
+    CBSTNODE *root = atomic_load_explicit(&tree->root, memory_order_relaxed);
+    if(!findCBSTNode(tree->compare, root, element) || !reserveCBSTNodes(tree, root)) {
+        pthread_mutex_unlock(&tree->writeLock);
+        return NULL;
+    }
+
+    BSTElement removed = NULL;
+    publishCBST(tree, removeCBSTNode(tree, root, element, &removed));
+    atomic_fetch_sub_explicit(&tree->size, 1, memory_order_relaxed);
+
+    pthread_mutex_unlock(&tree->writeLock);
+
+    return removed;
+}
+
+BSTElement findCBSTElement(CBST cbst, BSTElement element) {
+    if(PARAMETER_CHECK(!cbst || !element)) {
+        reportError("WARNING: Invalid parameters -- findCBSTElement --\n");
+        return NULL;
+    }
+
+    CBSTTREE *tree = (CBSTTREE *) cbst;
+
+    int slot = enterCBSTRead(tree);
+
+    CBSTNODE *node = findCBSTNode(tree->compare, atomic_load(&tree->root), element);
+    BSTElement found = (node) ? node->element : NULL;
+
+    exitCBSTRead(tree, slot);
+
+    return found;
+}
+
+void inOrderCBSTTraversal(CBST cbst, VisitCBSTElement visit, void *extra) {
+    if(PARAMETER_CHECK(!cbst)) {
+        reportError("WARNING: Invalid parameter -- inOrderCBSTTraversal --\n");
+        return;
+    }
+
+    CBSTTREE *tree = (CBSTTREE *) cbst;
+
+    int slot = enterCBSTRead(tree);
+
+    // Nodes have no parent pointers, the path from the root is kept in a stack
+    CBSTNODE *stack[CBST_MAX_HEIGHT];
+    int top = 0;
+
+    CBSTNODE *node = atomic_load(&tree->root);
+    while(node || top) {
+        for(; node; node = node->leftChild) stack[top++] = node;
+
+        node = stack[--top];
+        if(visit && visit(cbst, node->element, extra)) break;
+
+        node = node->rightChild;
+    }
+
+    exitCBSTRead(tree, slot);
+}
+
+void destroyCBST(CBST cbst) {
+    if(!cbst) return;
+
+    CBSTTREE *tree = (CBSTTREE *) cbst;
+
+    // Live, retired and spare nodes are dropped with the slabs of the pool
+    destroyPool(tree->pool);
+    pthread_mutex_destroy(&tree->writeLock);
+
+    free(tree);
+
+    cbst = NULL;
+}
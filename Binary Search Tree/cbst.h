@@ -0,0 +1,160 @@
+#ifndef CBST_H
+#define CBST_H
+
+/*
+    - This module implements a concurrent binary search tree(cbst) for read-mostly workloads
+      shared between threads
+
+    - A cbst is a self-balancing (AVL) bst (see bst.h) whose nodes are never modified once
+      they are reachable by readers:
+        - insertCBST and removeCBST copy the nodes on the path they change and publish the
+          new root with a single atomic store
+        - Writers are serialized by a lock, readers don't take any lock and never wait for writers
+
+    - Nodes replaced by a writer are freed only after every reader that could still be
+      using them has finished (epoch-based reclamation):
+        - Each reading thread announces the epoch it started in, in a slot of its own cache line
+        - Each write advances the epoch and frees the nodes retired before the oldest
+          announced epoch
+
+    - Up to CBST_MAX_THREADS threads get a slot of their own, the slot is returned when the
+      thread exits. Readers in other threads share a counter instead, which is slower and
+      delays freeing replaced nodes while any of them is reading
+
+    - Readers return elements instead of nodes, nodes are internal to the module
+
+    - findCBSTElement, inOrderCBSTTraversal, insertCBST, removeCBST, getCBSTSize and isCBSTEmpty can be
+      called by any number of threads at the same time, newCBST and destroyCBST cannot
+
+    - A valid element is a BSTElement != NULL
+
+    - Parameter checks are compiled out when DS_NO_CHECKS is defined (see Common/error.h)
+
+    - In this module its assumed CBST != NULL and BSTElement != NULL for functions that recieve
+      those as parameters
+
+    - It's necessary to free the memory allocated for CBST using the functions provided in this module
+*/
+
+#include <stdbool.h>
+
+#include "bst.h"
+
+// Maximum number of threads that read with a slot of their own at the same time
+#define CBST_MAX_THREADS 64
+
+typedef void *CBST;
+
+/*
+    - Function utilized by inOrderCBSTTraversal
+
+    - If this function returns true, the traversal will stop
+*/
+typedef bool (* VisitCBSTElement)(CBST cbst, BSTElement element, void *extra);
+
+/*
+    # Input:
+        - compare: Function to compare BSTElement for new CBST
+
+    # Description:
+        - Returns a pointer to a new empty cbst
+*/
+CBST newCBST(CompareElementsBST compare);
+
+/*
+    # Input:
+        - cbst: cbst
+
+    # Description:
+        - Returns true if cbst is empty, false otherwise
+
+        - With other threads working on cbst the result may be outdated
+          as soon as it is returned
+*/
+bool isCBSTEmpty(CBST cbst);
+
+/*
+    # Input:
+        - cbst: cbst
+
+    # Description:
+        - Returns the number of elements stored in cbst
+
+        - With other threads working on cbst the result may be outdated
+          as soon as it is returned
+*/
+int getCBSTSize(CBST cbst);
+
+/*
+    # Input:
+        - cbst: cbst
+        - element: Element to be inserted
+
+    # Description:
+        - Inserts element in cbst
+
+        - Copies O(log n) nodes, readers see either the tree before
+          or after the insertion
+
+        - Returns false if element could not be inserted
+*/
+bool insertCBST(CBST cbst, BSTElement element);
+
+/*
+    # Input:
+        - cbst: cbst
+        - element: Element to be removed, doesn't need to be the one stored in cbst
+
+    # Description:
+        - Removes an element equal to element from cbst and returns
+          the element that was stored
+
+        - If element is not in cbst, returns NULL
+*/
+BSTElement removeCBST(CBST cbst, BSTElement element);
+
+/*
+    # Input:
+        - cbst: cbst
+        - element: Searched element
+
+    # Description:
+        - Returns the element stored in cbst that is equal to element
+
+        - Doesn't take any lock, runs at the same time as other readers and writers
+
+        - If element is not in cbst, returns NULL
+*/
+BSTElement findCBSTElement(CBST cbst, BSTElement element);
+
+/*
+    # Input:
+        - cbst: cbst
+        - visit: Function to be used during the traversal
+        - extra: Extra pointer if necessary
+
+    # Description:
+        - Traverse cbst in-order
+
+        - The traversal visits the tree as it was when it started, elements inserted
+          or removed during the traversal, even by visit, are not seen
+
+        - Replaced nodes are not freed until the traversal ends, visit should
+          not take too long
+
+        - visit and extra can be NULL
+*/
+void inOrderCBSTTraversal(CBST cbst, VisitCBSTElement visit, void *extra);
+
+/*
+    # Input:
+        - cbst: cbst
+
+    # Description:
+        - Free all the memory used by cbst
+
+        - No other thread can be using cbst
+*/
+void destroyCBST(CBST cbst);
+
+#endif
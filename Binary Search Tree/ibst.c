@@ -0,0 +1,93 @@
+#include <stdlib.h>
+
+#include "ibst.h"
+#include "bst_generic.h"
+#include "../Common/error.h"
+
+// IBST handles point to an IBSTMap
+DEFINE_BST(IBSTMap, IBSTKey, BSTElement, BST_COMPARE_NUMBERS)
+
+IBST newIBST() {
+    return newIBSTMap();
+}
+
+bool isIBSTEmpty(IBST ibst) {
+    if(PARAMETER_CHECK(!ibst)) {
+        reportError("WARNING: Invalid parameter -- isIBSTEmpty --\n");
+        return true;
+    }
+
+    return getIBSTSize(ibst) == 0;
+}
+
+int getIBSTSize(IBST ibst) {
+    if(PARAMETER_CHECK(!ibst)) {
+        reportError("WARNING: Invalid parameter -- getIBSTSize --\n");
+        return 0;
+    }
+
+    return getIBSTMapSize((IBSTMap *) ibst);
+}
+
+int getIBSTHeight(IBST ibst) {
+    if(PARAMETER_CHECK(!ibst)) {
+        reportError("WARNING: Invalid parameter -- getIBSTHeight --\n");
+        return -1;
+    }
+
+    return getIBSTMapHeight((IBSTMap *) ibst);
+}
+
+bool insertIBST(IBST ibst, IBSTKey key, BSTElement element) {
+    if(PARAMETER_CHECK(!ibst || !element)) {
+        reportError("WARNING: Invalid parameters -- insertIBST --\n");
+        return false;
+    }
+
+    return insertIBSTMap((IBSTMap *) ibst, key, element) != NULL;
+}
+
+BSTElement removeIBST(IBST ibst, IBSTKey key) {
+    if(PARAMETER_CHECK(!ibst)) {
+        reportError("WARNING: Invalid parameter -- removeIBST --\n");
+        return NULL;
+    }
+
+    BSTElement element;
+
+    return (removeIBSTMap((IBSTMap *) ibst, key, &element)) ? element : NULL;
+}
+
+BSTElement findIBSTElement(IBST ibst, IBSTKey key) {
+    if(PARAMETER_CHECK(!ibst)) {
+        reportError("WARNING: Invalid parameter -- findIBSTElement --\n");
+        return NULL;
+    }
+
+    BSTElement *element = findIBSTMap((IBSTMap *) ibst, key);
+
+    return (element) ? *element : NULL;
+}
+
+void inOrderIBSTTraversal(IBST ibst, VisitIBSTElement visit, void *extra) {
+    if(PARAMETER_CHECK(!ibst)) {
+        reportError("WARNING: Invalid parameter -- inOrderIBSTTraversal --\n");
+        return;
+    }
+
+    if(!visit) return;
+
+    IBSTMapNode *node = iterIBSTMapBegin((IBSTMap *) ibst);
+
+    for(; node; node = getIBSTMapNodeSuccessor(node)) {
+        if(visit(ibst, node->key, node->value, extra)) return;
+    }
+}
+
+void destroyIBST(IBST ibst) {
+    if(!ibst) return;
+
+    destroyIBSTMap((IBSTMap *) ibst);
+
+    ibst = NULL;
+}
@@ -0,0 +1,140 @@
+#ifndef IBST_H
+#define IBST_H
+
+/*
+    - This module implements a binary search tree keyed by 64-bit integers(ibst)
+
+    - An ibst is a self-balancing (AVL) bst (see bst.h) that maps each IBSTKey to a BSTElement:
+        - The key is stored inside the node and compared directly, lookups don't call a
+          compare function or read the element
+        - The descent picks the next child by indexing with the result of the comparison
+          instead of branching on it
+
+    - Each key is stored once, inserting a key that is already in the ibst replaces its element
+
+    - Nodes are allocated from a node pool owned by the IBST
+
+    - An ibst is the instance of DEFINE_BST (see bst_generic.h) for IBSTKey keys and BSTElement
+      values, it shares the algorithms of the bsts generated there
+
+    - A valid element is a BSTElement != NULL
+
+    - Parameter checks are compiled out when DS_NO_CHECKS is defined (see Common/error.h)
+
+    - In this module its assumed IBST != NULL and BSTElement != NULL for functions that recieve
+      those as parameters
+
+    - It's necessary to free the memory allocated for IBST using the functions provided in this module
+*/
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "bst.h"
+
+typedef void *IBST;
+typedef int64_t IBSTKey;
+
+/*
+    - Function utilized by inOrderIBSTTraversal
+
+    - If this function returns true, the traversal will stop
+*/
+typedef bool (* VisitIBSTElement)(IBST ibst, IBSTKey key, BSTElement element, void *extra);
+
+/*
+    # Description:
+        - Returns a pointer to a new empty ibst
+*/
+IBST newIBST();
+
+/*
+    # Input:
+        - ibst: ibst
+
+    # Description:
+        - Returns true if ibst is empty, false otherwise
+*/
+bool isIBSTEmpty(IBST ibst);
+
+/*
+    # Input:
+        - ibst: ibst
+
+    # Description:
+        - Returns the number of keys stored in ibst
+*/
+int getIBSTSize(IBST ibst);
+
+/*
+    # Input:
+        - ibst: ibst
+
+    # Description:
+        - Returns the height of ibst, -1 if it is empty
+*/
+int getIBSTHeight(IBST ibst);
+
+/*
+    # Input:
+        - ibst: ibst
+        - key: Key to be inserted
+        - element: Element stored with key
+
+    # Description:
+        - Inserts key in ibst with element, if key is already
+          in ibst its element is replaced by element
+
+        - Returns false if key could not be inserted
+*/
+bool insertIBST(IBST ibst, IBSTKey key, BSTElement element);
+
+/*
+    # Input:
+        - ibst: ibst
+        - key: Key to be removed
+
+    # Description:
+        - Removes key from ibst and returns the element stored with it
+
+        - If key is not in ibst, returns NULL
+*/
+BSTElement removeIBST(IBST ibst, IBSTKey key);
+
+/*
+    # Input:
+        - ibst: ibst
+        - key: Searched key
+
+    # Description:
+        - Returns the element stored with key
+
+        - If key is not in ibst, returns NULL
+*/
+BSTElement findIBSTElement(IBST ibst, IBSTKey key);
+
+/*
+    # Input:
+        - ibst: ibst
+        - visit: Function to be used during the traversal
+        - extra: Extra pointer if necessary
+
+    # Description:
+        - Traverse ibst in-order, visiting the keys in ascending order
+
+        - visit must not change ibst
+
+        - visit and extra can be NULL
+*/
+void inOrderIBSTTraversal(IBST ibst, VisitIBSTElement visit, void *extra);
+
+/*
+    # Input:
+        - ibst: ibst
+
+    # Description:
+        - Free all the memory used by ibst
+*/
+void destroyIBST(IBST ibst);
+
+#endif
@@ -0,0 +1,540 @@
+#include <stdatomic.h>
+#include <stdlib.h>
+
+#include "pbst.h"
+#include "../Common/error.h"
+
+// An AVL tree with INT_MAX nodes is less than 45 levels high
+#define PBST_MAX_HEIGHT 64
+
+typedef struct pbstnode {
+    // Number of pbsts and nodes pointing to the node
+    atomic_int refs;
+    int height;
+    struct pbstnode *leftChild, *rightChild;
+    BSTElement element;
+}PBSTNODE;
+
+typedef struct {
+    CompareElementsBST compare;
+    PBSTNODE *root;
+    int size;
+
+    // Nodes allocated for the next writes, linked by leftChild
+    PBSTNODE *spare;
+    int spareCount;
+}PBSTTREE;
+
+/*
+    # Input:
+        - compare: Function to compare BSTElement for new PBST
+        - root: Root of the new pbst, the pbst takes the reference given by the caller
+        - size: Number of elements under root
+
+    # Description:
+        - Returns a pointer to a new pbst
+*/
+PBSTTREE *newPBSTTree(CompareElementsBST compare, PBSTNODE *root, int size) {
+    PBSTTREE *tree = (PBSTTREE *) malloc(sizeof(PBSTTREE));
+    if(!tree) return NULL;
+
+    tree->compare = compare;
+    tree->root = root;
+    tree->size = size;
+    tree->spare = NULL;
+    tree->spareCount = 0;
+
+    return tree;
+}
+
+PBST newPBST(CompareElementsBST compare) {
+    if(PARAMETER_CHECK(!compare)) {
+        reportError("WARNING: Invalid parameter -- newPBST --\n");
+        return NULL;
+    }
+
+    PBSTTREE *tree = newPBSTTree(compare, NULL, 0);
+    if(!tree) {
+        reportError("ERROR: Could not allocate memory for new pbst -- newPBST --\n");
+        return NULL;
+    }
+
+    return tree;
+}
+
+/*
+    # Input:
+        - node: Node from a pbst, can be NULL
+
+    # Description:
+        - Adds a reference to node
+*/
+void acquirePBSTNode(PBSTNODE *node) {
+    if(node) atomic_fetch_add_explicit(&node->refs, 1, memory_order_relaxed);
+}
+
+/*
+    # Input:
+        - node: Node from a pbst, can be NULL
+
+    # Description:
+        - Drops a reference to node, if it was the last one node is freed
+          and its references to its children are dropped
+*/
+void releasePBSTNode(PBSTNODE *node) {
+    // Acquire so every use of node by other threads happens before it is freed
+    while(node && atomic_fetch_sub_explicit(&node->refs, 1, memory_order_acq_rel) == 1) {
+        releasePBSTNode(node->leftChild);
+
+        PBSTNODE *right = node->rightChild;
+        free(node);
+
+        node = right;
+    }
+}
+
+PBST snapshotPBST(PBST pbst) {
+    if(PARAMETER_CHECK(!pbst)) {
+        reportError("WARNING: Invalid parameter -- snapshotPBST --\n");
+        return NULL;
+    }
+
+    PBSTTREE *tree = (PBSTTREE *) pbst;
+
+    PBSTTREE *snapshot = newPBSTTree(tree->compare, tree->root, tree->size);
+    if(!snapshot) {
+        reportError("ERROR: Could not allocate memory for new pbst -- snapshotPBST --\n");
+        return NULL;
+    }
+
+    acquirePBSTNode(tree->root);
+
+    return snapshot;
+}
+
+bool isPBSTEmpty(PBST pbst) {
+    if(PARAMETER_CHECK(!pbst)) {
+        reportError("WARNING: Invalid parameter -- isPBSTEmpty --\n");
+        return true;
+    }
+
+    return getPBSTSize(pbst) == 0;
+}
+
+int getPBSTSize(PBST pbst) {
+    if(PARAMETER_CHECK(!pbst)) {
+        reportError("WARNING: Invalid parameter -- getPBSTSize --\n");
+        return 0;
+    }
+
+    PBSTTREE *tree = (PBSTTREE *) pbst;
+
+    return tree->size;
+}
+
+/*
+    # Input:
+        - node: Node from a pbst
+
+    # Description:
+        - Returns the height of the subtree rooted at node, -1 if node is NULL
+*/
+int getPBSTNodeHeight(PBSTNODE *node) {
+    return (node) ? node->height : -1;
+}
+
+/*
+    # Input:
+        - tree: pbst
+        - root: Current root of tree
+
+    # Description:
+        - Allocates every node a write may need in the spare nodes of tree,
+          so a write never fails after it has started copying nodes
+
+        - Each level of the path copies at most the node, a child and a grandchild
+          when it is rotated, the nodes not used are kept for the next write
+
+        - Returns false if memory could not be allocated
+*/
+bool reservePBSTNodes(PBSTTREE *tree, PBSTNODE *root) {
+    int count = 3 * (getPBSTNodeHeight(root) + 2);
+
+    while(tree->spareCount < count) {
+        PBSTNODE *node = (PBSTNODE *) malloc(sizeof(PBSTNODE));
+        if(!node) {
+            reportError("ERROR: Could not allocate memory for new pbst node -- reservePBSTNodes --\n");
+            return false;
+        }
+
+        node->leftChild = tree->spare;
+        tree->spare = node;
+        tree->spareCount++;
+    }
+
+    return true;
+}
+
+/*
+    # Input:
+        - tree: pbst
+
+    # Description:
+        - Returns a node from the spare nodes of tree with a single reference
+
+        - The nodes must have been reserved with reservePBSTNodes
+*/
+PBSTNODE *takePBSTSpareNode(PBSTTREE *tree) {
+    PBSTNODE *node = tree->spare;
+
+    tree->spare = node->leftChild;
+    tree->spareCount--;
+
+    atomic_init(&node->refs, 1);
+
+    return node;
+}
+
+/*
+    # Input:
+        - tree: pbst
+        - element: Element stored in the node
+
+    # Description:
+        - Returns a new leaf
+*/
+PBSTNODE *newPBSTNode(PBSTTREE *tree, BSTElement element) {
+    PBSTNODE *node = takePBSTSpareNode(tree);
+
+    node->height = 0;
+    node->leftChild = NULL;
+    node->rightChild = NULL;
+    node->element = element;
+
+    return node;
+}
+
+/*
+    # Input:
+        - tree: pbst
+        - node: Node referenced by its parent in tree, or by tree if it is the root
+
+    # Description:
+        - Returns a node that can be modified in place and takes the place of node:
+          node itself if only its parent references it, otherwise a copy of node,
+          and the reference to node is dropped
+
+        - Nodes on the path to node must have been made modifiable first
+*/
+PBSTNODE *mutablePBSTNode(PBSTTREE *tree, PBSTNODE *node) {
+    // Acquire so the last uses of node by the pbsts that dropped it happen before the changes
+    if(atomic_load_explicit(&node->refs, memory_order_acquire) == 1) return node;
+
+    PBSTNODE *copy = takePBSTSpareNode(tree);
+    copy->height = node->height;
+    copy->leftChild = node->leftChild;
+    copy->rightChild = node->rightChild;
+    copy->element = node->element;
+
+    // The children are now also referenced by the copy
+    acquirePBSTNode(copy->leftChild);
+    acquirePBSTNode(copy->rightChild);
+
+    releasePBSTNode(node);
+
+    return copy;
+}
+
+/*
+    # Input:
+        - node: Node that can be modified in place
+
+    # Description:
+        - Recalculates the height of node from its children
+*/
+void updatePBSTNode(PBSTNODE *node) {
+    int left = getPBSTNodeHeight(node->leftChild);
+    int right = getPBSTNodeHeight(node->rightChild);
+
+    node->height = 1 + ((left > right) ? left : right);
+}
+
+/*
+    # Input:
+        - tree: pbst
+        - node: Root of the subtree to be rotated, must have a right child
+
+    # Description:
+        - Rotates the subtree rooted at node to the left and returns its new root,
+          node and its right child are copied if they are shared
+*/
+PBSTNODE *rotatePBSTLeft(PBSTTREE *tree, PBSTNODE *node) {
+    node = mutablePBSTNode(tree, node);
+    PBSTNODE *pivot = mutablePBSTNode(tree, node->rightChild);
+
+    // References move with the pointers, no count changes
+    node->rightChild = pivot->leftChild;
+    pivot->leftChild = node;
+
+    updatePBSTNode(node);
+    updatePBSTNode(pivot);
+
+    return pivot;
+}
+
+/*
+    # Input:
+        - tree: pbst
+        - node: Root of the subtree to be rotated, must have a left child
+
+    # Description:
+        - Rotates the subtree rooted at node to the right and returns its new root,
+          node and its left child are copied if they are shared
+*/
+PBSTNODE *rotatePBSTRight(PBSTTREE *tree, PBSTNODE *node) {
+    node = mutablePBSTNode(tree, node);
+    PBSTNODE *pivot = mutablePBSTNode(tree, node->leftChild);
+
+    node->leftChild = pivot->rightChild;
+    pivot->rightChild = node;
+
+    updatePBSTNode(node);
+    updatePBSTNode(pivot);
+
+    return pivot;
+}
+
+/*
+    # Input:
+        - tree: pbst
+        - node: Node that can be modified in place, whose children may be unbalanced by one level
+
+    # Description:
+        - Restores the AVL property of the subtree rooted at node and returns its new root
+*/
+PBSTNODE *rebalancePBST(PBSTTREE *tree, PBSTNODE *node) {
+    updatePBSTNode(node);
+
+    int balance = getPBSTNodeHeight(node->leftChild) - getPBSTNodeHeight(node->rightChild);
+
+    if(balance > 1) {
+        PBSTNODE *left = node->leftChild;
+        if(getPBSTNodeHeight(left->leftChild) < getPBSTNodeHeight(left->rightChild)) node->leftChild = rotatePBSTLeft(tree, left);
+
+        return rotatePBSTRight(tree, node);
+    }
+
+    if(balance < -1) {
+        PBSTNODE *right = node->rightChild;
+        if(getPBSTNodeHeight(right->rightChild) < getPBSTNodeHeight(right->leftChild)) node->rightChild = rotatePBSTRight(tree, right);
+
+        return rotatePBSTLeft(tree, node);
+    }
+
+    return node;
+}
+
+/*
+    # Input:
+        - tree: pbst
+        - node: Root of a subtree of tree
+        - element: Element to be inserted
+
+    # Description:
+        - Inserts element in the subtree rooted at node, copying the shared
+          nodes on its path, and returns the new root of the subtree
+*/
+PBSTNODE *insertPBSTNode(PBSTTREE *tree, PBSTNODE *node, BSTElement element) {
+    if(!node) return newPBSTNode(tree, element);
+
+    node = mutablePBSTNode(tree, node);
+
+    if(tree->compare(element, node->element) > 0) node->rightChild = insertPBSTNode(tree, node->rightChild, element);
+    else node->leftChild = insertPBSTNode(tree, node->leftChild, element);
+
+    return rebalancePBST(tree, node);
+}
+
+/*
+    # Input:
+        - node: Node with at most one child, referenced by its parent
+
+    # Description:
+        - Unlinks node from its parent and returns its child, which takes
+          the place of node
+*/
+PBSTNODE *unlinkPBSTNode(PBSTNODE *node) {
+    PBSTNODE *child = (node->leftChild) ? node->leftChild : node->rightChild;
+
+    // The parent takes a reference to child before the one of node is dropped
+    acquirePBSTNode(child);
+    releasePBSTNode(node);
+
+    return child;
+}
+
+/*
+    # Input:
+        - tree: pbst
+        - node: Root of a subtree of tree, must not be NULL
+        - element: Where the smallest element of the subtree is stored
+
+    # Description:
+        - Removes the smallest element from the subtree rooted at node, copying
+          the shared nodes on its path, and returns the new root of the subtree
+*/
+PBSTNODE *removePBSTSmallest(PBSTTREE *tree, PBSTNODE *node, BSTElement *element) {
+    if(!node->leftChild) {
+        *element = node->element;
+
+        return unlinkPBSTNode(node);
+    }
+
+    node = mutablePBSTNode(tree, node);
+    node->leftChild = removePBSTSmallest(tree, node->leftChild, element);
+
+    return rebalancePBST(tree, node);
+}
+
+/*
+    # Input:
+        - tree: pbst
+        - node: Root of a subtree of tree that contains element
+        - element: Element to be removed
+        - removed: Where the removed element is stored
+
+    # Description:
+        - Removes element from the subtree rooted at node, copying the shared
+          nodes on its path, and returns the new root of the subtree
+*/
+PBSTNODE *removePBSTNode(PBSTTREE *tree, PBSTNODE *node, BSTElement element, BSTElement *removed) {
+    int cmp = tree->compare(element, node->element);
+
+    if(cmp == 0) {
+        *removed = node->element;
+
+        if(!node->leftChild || !node->rightChild) return unlinkPBSTNode(node);
+
+        // The node keeps its place with the element of its successor
+        node = mutablePBSTNode(tree, node);
+        node->rightChild = removePBSTSmallest(tree, node->rightChild, &node->element);
+
+        return rebalancePBST(tree, node);
+    }
+
+    node = mutablePBSTNode(tree, node);
+
+    if(cmp > 0) node->rightChild = removePBSTNode(tree, node->rightChild, element, removed);
+    else node->leftChild = removePBSTNode(tree, node->leftChild, element, removed);
+
+    return rebalancePBST(tree, node);
+}
+
+/*
+    # Input:
+        - compare: Function to compare 2 bst elements
+        - node: Node from a pbst
+        - element: Searched element
+
+    # Description:
+        - Returns the node in the subtree rooted at node that stores element,
+          if it doesn't exist, returns NULL
+*/
+PBSTNODE *findPBSTNode(CompareElementsBST compare, PBSTNODE *node, BSTElement element) {
+    while(node) {
+        int cmp = compare(element, node->element);
+
+        if(cmp == 0) return node;
+        node = (cmp > 0) ? node->rightChild : node->leftChild;
+    }
+
+    return NULL;
+}
+
+bool insertPBST(PBST pbst, BSTElement element) {
+    if(PARAMETER_CHECK(!pbst || !element)) {
+        reportError("WARNING: Invalid parameters -- insertPBST --\n");
+        return false;
+    }
+
+    PBSTTREE *tree = (PBSTTREE *) pbst;
+
+    if(!reservePBSTNodes(tree, tree->root)) return false;
+
+    tree->root = insertPBSTNode(tree, tree->root, element);
+    tree->size++;
+
+    return true;
+}
+
+BSTElement removePBST(PBST pbst, BSTElement element) {
+    if(PARAMETER_CHECK(!pbst || !element)) {
+        reportError("WARNING: Invalid parameters -- removePBST --\n");
+        return NULL;
+    }
+
+    PBSTTREE *tree = (PBSTTREE *) pbst;
+
+    if(!findPBSTNode(tree->compare, tree->root, element) || !reservePBSTNodes(tree, tree->root)) return NULL;
+
+    BSTElement removed = NULL;
+    tree->root = removePBSTNode(tree, tree->root, element, &removed);
+    tree->size--;
+
+    return removed;
+}
+
+BSTElement findPBSTElement(PBST pbst, BSTElement element) {
+    if(PARAMETER_CHECK(!pbst || !element)) {
+        reportError("WARNING: Invalid parameters -- findPBSTElement --\n");
+        return NULL;
+    }
+
+    PBSTTREE *tree = (PBSTTREE *) pbst;
+
+    PBSTNODE *node = findPBSTNode(tree->compare, tree->root, element);
+
+    return (node) ? node->element : NULL;
+}
+
+void inOrderPBSTTraversal(PBST pbst, VisitPBSTElement visit, void *extra) {
+    if(PARAMETER_CHECK(!pbst)) {
+        reportError("WARNING: Invalid parameter -- inOrderPBSTTraversal --\n");
+        return;
+    }
+
+    PBSTTREE *tree = (PBSTTREE *) pbst;
+
+    // Nodes have no parent pointers, they can have several parents
+    PBSTNODE *stack[PBST_MAX_HEIGHT];
+    int top = 0;
+
+    PBSTNODE *node = tree->root;
+    while(node || top) {
+        for(; node; node = node->leftChild) stack[top++] = node;
+
+        node = stack[--top];
+        if(visit && visit(pbst, node->element, extra)) break;
+
+        node = node->rightChild;
+    }
+}
+
+void destroyPBST(PBST pbst) {
+    if(!pbst) return;
+
+    PBSTTREE *tree = (PBSTTREE *) pbst;
+
+    releasePBSTNode(tree->root);
+
+    while(tree->spare) {
+        PBSTNODE *node = tree->spare;
+        tree->spare = node->leftChild;
+
+        free(node);
+    }
+
+    free(tree);
+
+    pbst = NULL;
+}
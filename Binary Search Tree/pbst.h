@@ -0,0 +1,145 @@
+#ifndef PBST_H
+#define PBST_H
+
+/*
+    - This module implements a persistent binary search tree(pbst), where a point-in-time
+      copy of the tree (snapshot) is taken in O(1)
+
+    - A pbst is a self-balancing (AVL) bst (see bst.h) whose nodes can be shared by several pbsts:
+        - snapshotPBST returns a new pbst that shares every node with the original
+        - insertPBST and removePBST modify in place the nodes used only by the pbst, and copy
+          the shared nodes on the path they change, allocating O(log n) nodes
+        - Changes to a pbst are never seen by its snapshots, and the other way around
+
+    - Nodes count the pbsts and nodes that point to them, a node is freed when the last of
+      them is destroyed
+
+    - A pbst can only be used by one thread at a time, pbsts that share nodes can be used by
+      different threads at the same time (for example a long scan of a snapshot while another
+      thread keeps changing the original)
+
+    - A valid element is a BSTElement != NULL
+
+    - Parameter checks are compiled out when DS_NO_CHECKS is defined (see Common/error.h)
+
+    - In this module its assumed PBST != NULL and BSTElement != NULL for functions that recieve
+      those as parameters
+
+    - It's necessary to free the memory allocated for PBST using the functions provided in this module
+*/
+
+#include <stdbool.h>
+
+#include "bst.h"
+
+typedef void *PBST;
+
+/*
+    - Function utilized by inOrderPBSTTraversal
+
+    - If this function returns true, the traversal will stop
+*/
+typedef bool (* VisitPBSTElement)(PBST pbst, BSTElement element, void *extra);
+
+/*
+    # Input:
+        - compare: Function to compare BSTElement for new PBST
+
+    # Description:
+        - Returns a pointer to a new empty pbst
+*/
+PBST newPBST(CompareElementsBST compare);
+
+/*
+    # Input:
+        - pbst: pbst
+
+    # Description:
+        - Returns a new pbst with the same elements as pbst, in O(1)
+
+        - The new pbst and pbst share their nodes until one of them is changed,
+          each one must be destroyed with destroyPBST
+*/
+PBST snapshotPBST(PBST pbst);
+
+/*
+    # Input:
+        - pbst: pbst
+
+    # Description:
+        - Returns true if pbst is empty, false otherwise
+*/
+bool isPBSTEmpty(PBST pbst);
+
+/*
+    # Input:
+        - pbst: pbst
+
+    # Description:
+        - Returns the number of elements stored in pbst
+*/
+int getPBSTSize(PBST pbst);
+
+/*
+    # Input:
+        - pbst: pbst
+        - element: Element to be inserted
+
+    # Description:
+        - Inserts element in pbst, snapshots of pbst are not changed
+
+        - Returns false if element could not be inserted
+*/
+bool insertPBST(PBST pbst, BSTElement element);
+
+/*
+    # Input:
+        - pbst: pbst
+        - element: Element to be removed, doesn't need to be the one stored in pbst
+
+    # Description:
+        - Removes an element equal to element from pbst and returns
+          the element that was stored, snapshots of pbst are not changed
+
+        - If element is not in pbst, returns NULL
+*/
+BSTElement removePBST(PBST pbst, BSTElement element);
+
+/*
+    # Input:
+        - pbst: pbst
+        - element: Searched element
+
+    # Description:
+        - Returns the element stored in pbst that is equal to element
+
+        - If element is not in pbst, returns NULL
+*/
+BSTElement findPBSTElement(PBST pbst, BSTElement element);
+
+/*
+    # Input:
+        - pbst: pbst
+        - visit: Function to be used during the traversal
+        - extra: Extra pointer if necessary
+
+    # Description:
+        - Traverse pbst in-order
+
+        - visit must not change pbst, it can change a snapshot of it
+
+        - visit and extra can be NULL
+*/
+void inOrderPBSTTraversal(PBST pbst, VisitPBSTElement visit, void *extra);
+
+/*
+    # Input:
+        - pbst: pbst
+
+    # Description:
+        - Free all the memory used by pbst, nodes still used by
+          other pbsts are kept for them
+*/
+void destroyPBST(PBST pbst);
+
+#endif
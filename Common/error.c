@@ -0,0 +1,25 @@
+#include <stdio.h>
+
+#include "error.h"
+
+/*
+    # Description:
+        - Default ErrorHandler, prints message to stdout
+*/
+void printError(const char *message, void *extra) {
+    (void) extra;
+
+    printf("%s", message);
+}
+
+ErrorHandler errorHandler = printError;
+void *errorHandlerExtra = NULL;
+
+void setErrorHandler(ErrorHandler handler, void *extra) {
+    errorHandler = (handler) ? handler : printError;
+    errorHandlerExtra = extra;
+}
+
+void reportError(const char *message) {
+    errorHandler(message, errorHandlerExtra);
+}
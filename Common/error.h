@@ -0,0 +1,52 @@
+#ifndef ERROR_H
+#define ERROR_H
+
+/*
+    - This module centralizes the error reporting of the data structure modules
+
+    - Every module reports invalid parameters and failed allocations through reportError, by default
+      the messages are printed to stdout, setErrorHandler redirects them to a user function
+
+    - Defining DS_NO_CHECKS when building the modules and the code that uses them compiles out the
+      parameter checks (PARAMETER_CHECK is always false) and replaces the trivial accessors of
+      the List and BST modules by inline versions. Passing invalid parameters is then undefined
+      behaviour, allocation failures are still reported
+*/
+
+/*
+    - Function that receives the error messages
+
+    - message is a complete line, ending in '\n'
+
+    - extra is the pointer given to setErrorHandler
+*/
+typedef void (* ErrorHandler)(const char *message, void *extra);
+
+#ifdef DS_NO_CHECKS
+#define PARAMETER_CHECK(invalid) (0 && (invalid))
+#else
+#define PARAMETER_CHECK(invalid) (invalid)
+#endif
+
+/*
+    # Input:
+        - handler: Function that will receive the error messages
+        - extra: Extra pointer given to handler if necessary
+    
+    # Description:
+        - Makes handler receive every error message reported from now on
+
+        - If handler is NULL, messages are printed to stdout again
+*/
+void setErrorHandler(ErrorHandler handler, void *extra);
+
+/*
+    # Input:
+        - message: Error message
+    
+    # Description:
+        - Reports message to the current error handler
+*/
+void reportError(const char *message);
+
+#endif
@@ -0,0 +1,202 @@
+#include <pthread.h>
+#include <stdatomic.h>
+#include <stdlib.h>
+
+#include "clist.h"
+#include "../Common/error.h"
+
+// Size of a cache line, the fields used by producers and consumers are kept in different lines
+#define CLIST_CACHE_LINE 64
+
+typedef struct clistnode {
+    ListElement element;
+    _Atomic(struct clistnode *) next;
+}CLISTNODE;
+
+typedef struct {
+    // Used by consumers, head is a dummy node whose next is the first element
+    _Alignas(CLIST_CACHE_LINE) pthread_mutex_t headLock;
+    CLISTNODE *head;
+
+    // Used by producers, tail is the last node
+    _Alignas(CLIST_CACHE_LINE) pthread_mutex_t tailLock;
+    CLISTNODE *tail;
+
+    _Alignas(CLIST_CACHE_LINE) atomic_int size;
+}CLIST;
+
+/*
+    # Input:
+        - element: Element stored in the node
+    
+    # Description:
+        - Returns a pointer to a new clist node
+*/
+CLISTNODE *newCListNode(ListElement element) {
+    CLISTNODE *node = (CLISTNODE *) malloc(sizeof(CLISTNODE));
+    if(!node) {
+        reportError("ERROR: Could not allocate memory for new clist node -- newCListNode --\n");
+        return NULL;
+    }
+
+    node->element = element;
+    atomic_init(&node->next, NULL);
+
+    return node;
+}
+
+CList newCList() {
+    CLIST *cl = (CLIST *) aligned_alloc(_Alignof(CLIST), sizeof(CLIST));
+    if(!cl) {
+        reportError("ERROR: Could not allocate memory for new clist -- newCList --\n");
+        return NULL;
+    }
+
+    cl->head = newCListNode(NULL);
+    if(!cl->head) {
+        reportError("ERROR: Could not allocate memory for new clist -- newCList --\n");
+        free(cl);
+        return NULL;
+    }
+
+    cl->tail = cl->head;
+    pthread_mutex_init(&cl->headLock, NULL);
+    pthread_mutex_init(&cl->tailLock, NULL);
+    atomic_init(&cl->size, 0);
+
+    return cl;
+}
+
+bool isCListEmpty(CList clist) {
+    if(PARAMETER_CHECK(!clist)) {
+        reportError("WARNING: Invalid parameter -- isCListEmpty --\n");
+        return true;
+    }
+
+    return getCListSize(clist) == 0;
+}
+
+int getCListSize(CList clist) {
+    if(PARAMETER_CHECK(!clist)) {
+        reportError("WARNING: Invalid parameter -- getCListSize --\n");
+        return 0;
+    }
+
+    CLIST *cl = (CLIST *) clist;
+
+    return atomic_load_explicit(&cl->size, memory_order_relaxed);
+}
+
+bool pushCList(CList clist, ListElement element) {
+    if(PARAMETER_CHECK(!clist || !element)) {
+        reportError("WARNING: Invalid parameters -- pushCList --\n");
+        return false;
+    }
+
+    CLIST *cl = (CLIST *) clist;
+
+    CLISTNODE *node = newCListNode(element);
+    if(!node) return false;
+
+    pthread_mutex_lock(&cl->headLock);
+
+    CLISTNODE *first = atomic_load_explicit(&cl->head->next, memory_order_acquire);
+
+    // On an empty clist the dummy is also the tail, producers must be kept out while it is linked
+    bool empty = !first;
+    if(empty) {
+        pthread_mutex_lock(&cl->tailLock);
+
+        first = atomic_load_explicit(&cl->head->next, memory_order_acquire);
+        if(!first) cl->tail = node;
+    }
+
+    atomic_store_explicit(&node->next, first, memory_order_relaxed);
+    atomic_store_explicit(&cl->head->next, node, memory_order_release);
+
+    if(empty) pthread_mutex_unlock(&cl->tailLock);
+
+    atomic_fetch_add_explicit(&cl->size, 1, memory_order_relaxed);
+
+    pthread_mutex_unlock(&cl->headLock);
+
+    return true;
+}
+
+bool insertEndCList(CList clist, ListElement element) {
+    if(PARAMETER_CHECK(!clist || !element)) {
+        reportError("WARNING: Invalid parameters -- insertEndCList --\n");
+        return false;
+    }
+
+    CLIST *cl = (CLIST *) clist;
+
+    CLISTNODE *node = newCListNode(element);
+    if(!node) return false;
+
+    pthread_mutex_lock(&cl->tailLock);
+
+    // Publishes node to consumers, its fields are visible to them once they see it
+    atomic_store_explicit(&cl->tail->next, node, memory_order_release);
+    cl->tail = node;
+
+    atomic_fetch_add_explicit(&cl->size, 1, memory_order_relaxed);
+
+    pthread_mutex_unlock(&cl->tailLock);
+
+    return true;
+}
+
+ListElement popCList(CList clist) {
+    if(PARAMETER_CHECK(!clist)) {
+        reportError("WARNING: Invalid parameter -- popCList --\n");
+        return NULL;
+    }
+
+    CLIST *cl = (CLIST *) clist;
+
+    pthread_mutex_lock(&cl->headLock);
+
+    CLISTNODE *dummy = cl->head;
+    CLISTNODE *first = atomic_load_explicit(&dummy->next, memory_order_acquire);
+
+    if(!first) {
+        pthread_mutex_unlock(&cl->headLock);
+        return NULL;
+    }
+
+    // first becomes the new dummy
+    ListElement element = first->element;
+    first->element = NULL;
+    cl->head = first;
+
+    atomic_fetch_sub_explicit(&cl->size, 1, memory_order_relaxed);
+
+    pthread_mutex_unlock(&cl->headLock);
+
+    // A producer can only reach the old dummy while it is the tail, and it stopped being the tail
+    // before first was linked to it
+    free(dummy);
+
+    return element;
+}
+
+void destroyCList(CList clist) {
+    if(!clist) return;
+
+    CLIST *cl = (CLIST *) clist;
+
+    CLISTNODE *node = cl->head;
+    while(node) {
+        CLISTNODE *next = atomic_load_explicit(&node->next, memory_order_relaxed);
+
+        free(node);
+        node = next;
+    }
+
+    pthread_mutex_destroy(&cl->headLock);
+    pthread_mutex_destroy(&cl->tailLock);
+
+    free(cl);
+    clist = NULL;
+}
@@ -0,0 +1,112 @@
+#ifndef CLIST_H
+#define CLIST_H
+
+/*
+    - This module implements a concurrent list(clist) to be shared as a work queue between threads
+
+    - A clist is a singly linked list with a dummy node at its head, guarded by two locks
+      (two-lock queue of Michael and Scott):
+        - The head lock is taken by popCList and pushCList
+        - The tail lock is taken by insertEndCList
+      so producers appending to the end never wait for consumers taking from the start
+
+    - The node removed by popCList is only touched by threads holding the head lock, so it is freed
+      as soon as the lock is released, no other reclamation scheme is needed
+
+    - pushCList, insertEndCList, popCList, getCListSize and isCListEmpty can be called by any
+      number of threads at the same time, newCList and destroyCList cannot
+
+    - A valid element is a ListElement != NULL
+
+    - Parameter checks are compiled out when DS_NO_CHECKS is defined (see Common/error.h)
+
+    - In this module its assumed CList != NULL and ListElement != NULL for functions that recieve
+      those as parameters 
+
+    - It's necessary to free the memory allocated for CList using the functions provided in this module
+*/
+
+#include <stdbool.h>
+
+#include "list.h"
+
+typedef void *CList;
+
+/*
+    # Description:
+        - Returns a pointer to a new empty clist
+*/
+CList newCList();
+
+/*
+    # Input:
+        - clist: clist
+    
+    # Description:
+        - Returns true if clist is empty, false otherwise
+
+        - With other threads working on clist the result may be outdated
+          as soon as it is returned
+*/
+bool isCListEmpty(CList clist);
+
+/*
+    # Input:
+        - clist: clist
+    
+    # Description:
+        - Return the number of elements stored in clist
+
+        - With other threads working on clist the result may be outdated
+          as soon as it is returned
+*/
+int getCListSize(CList clist);
+
+/*
+    # Inputs:
+        - clist: clist
+        - element: Element to be stored in clist
+
+    # Description:
+        - Insert element at the start of clist
+
+        - Returns false if element could not be inserted
+*/
+bool pushCList(CList clist, ListElement element);
+
+/*
+    # Inputs:
+        - clist: clist
+        - element: Element to be stored in clist
+
+    # Description:
+        - Insert element at the end of clist
+
+        - Returns false if element could not be inserted
+*/
+bool insertEndCList(CList clist, ListElement element);
+
+/*
+    # Input:
+        - clist: clist
+
+    # Description:
+        - Removes the first element from clist
+          and returns it
+        
+        - Returns NULL if clist is empty
+*/
+ListElement popCList(CList clist);
+
+/*
+    # Input:
+        - clist: clist
+    
+    # Description:
+        - Free all the memory used by clist
+
+        - No other thread can be using clist
+*/
+void destroyCList(CList clist);
+
+#endif
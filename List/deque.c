@@ -0,0 +1,277 @@
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "deque.h"
+#include "../Common/error.h"
+
+typedef struct {
+    // elements[(first + i) & (capacity - 1)] is the element at position i
+    ListElement *elements;
+    int capacity, first, size;
+}DEQUE;
+
+Deque newDeque() {
+    DEQUE *dq = (DEQUE *) malloc(sizeof(DEQUE));
+    if(!dq) {
+        reportError("ERROR: Could not allocate memory for new deque -- newDeque --\n");
+        return NULL;
+    }
+
+    dq->elements = (ListElement *) malloc(DEQUE_MIN_CAPACITY * sizeof(ListElement));
+    if(!dq->elements) {
+        reportError("ERROR: Could not allocate memory for new deque -- newDeque --\n");
+        free(dq);
+        return NULL;
+    }
+
+    dq->capacity = DEQUE_MIN_CAPACITY;
+    dq->first = 0;
+    dq->size = 0;
+
+    return dq;
+}
+
+bool isDequeEmpty(Deque deque) {
+    if(PARAMETER_CHECK(!deque)) {
+        reportError("WARNING: Invalid parameter -- isDequeEmpty --\n");
+        return true;
+    }
+
+    return getDequeSize(deque) == 0;
+}
+
+int getDequeSize(Deque deque) {
+    if(PARAMETER_CHECK(!deque)) {
+        reportError("WARNING: Invalid parameter -- getDequeSize --\n");
+        return 0;
+    }
+
+    DEQUE *dq = (DEQUE *) deque;
+
+    return dq->size;
+}
+
+/*
+    # Input:
+        - dq: deque
+        - capacity: New capacity, a power of 2 >= dq->size
+
+    # Description:
+        - Moves the elements of dq to a new array with capacity elements,
+          the first element is placed at the start of the new array
+
+        - Returns false if memory could not be allocated
+*/
+bool resizeDeque(DEQUE *dq, int capacity) {
+    // Where size_t is 32 bits the array size can overflow it
+    ListElement *elements = NULL;
+    if((size_t) capacity <= SIZE_MAX / sizeof(ListElement)) elements = (ListElement *) malloc((size_t) capacity * sizeof(ListElement));
+
+    if(!elements) {
+        reportError("ERROR: Could not allocate memory for deque elements -- resizeDeque --\n");
+        return false;
+    }
+
+    // The elements may wrap around the end of the old array, they are copied in 2 pieces
+    int end = dq->capacity - dq->first;
+    int head = (dq->size < end) ? dq->size : end;
+
+    memcpy(elements, dq->elements + dq->first, head * sizeof(ListElement));
+    memcpy(elements + head, dq->elements, (dq->size - head) * sizeof(ListElement));
+
+    free(dq->elements);
+
+    dq->elements = elements;
+    dq->capacity = capacity;
+    dq->first = 0;
+
+    return true;
+}
+
+/*
+    # Input:
+        - dq: deque, full
+
+    # Description:
+        - Doubles the capacity of dq
+
+        - Returns false if dq already has DEQUE_MAX_CAPACITY or memory could not be allocated
+*/
+bool growDeque(DEQUE *dq) {
+    if(dq->capacity == DEQUE_MAX_CAPACITY) {
+        reportError("ERROR: Deque can't store more elements -- growDeque --\n");
+        return false;
+    }
+
+    return resizeDeque(dq, 2 * dq->capacity);
+}
+
+bool reserveDeque(Deque deque, int capacity) {
+    if(PARAMETER_CHECK(!deque || capacity < 0)) {
+        reportError("WARNING: Invalid parameters -- reserveDeque --\n");
+        return false;
+    }
+
+    DEQUE *dq = (DEQUE *) deque;
+
+    if(capacity <= dq->capacity) return true;
+
+    // Doubling up to a larger capacity would overflow newCapacity
+    if(capacity > DEQUE_MAX_CAPACITY) {
+        reportError("ERROR: Capacity is larger than DEQUE_MAX_CAPACITY -- reserveDeque --\n");
+        return false;
+    }
+
+    int newCapacity = dq->capacity;
+    while(newCapacity < capacity) newCapacity *= 2;
+
+    return resizeDeque(dq, newCapacity);
+}
+
+bool pushDeque(Deque deque, ListElement element) {
+    if(PARAMETER_CHECK(!deque || !element)) {
+        reportError("WARNING: Invalid parameters -- pushDeque --\n");
+        return false;
+    }
+
+    DEQUE *dq = (DEQUE *) deque;
+
+    if(dq->size == dq->capacity && !growDeque(dq)) return false;
+
+    dq->first = (dq->first - 1) & (dq->capacity - 1);
+    dq->elements[dq->first] = element;
+    dq->size++;
+
+    return true;
+}
+
+bool insertEndDeque(Deque deque, ListElement element) {
+    if(PARAMETER_CHECK(!deque || !element)) {
+        reportError("WARNING: Invalid parameters -- insertEndDeque --\n");
+        return false;
+    }
+
+    DEQUE *dq = (DEQUE *) deque;
+
+    if(dq->size == dq->capacity && !growDeque(dq)) return false;
+
+    dq->elements[(dq->first + dq->size) & (dq->capacity - 1)] = element;
+    dq->size++;
+
+    return true;
+}
+
+ListElement popDeque(Deque deque) {
+    if(PARAMETER_CHECK(!deque)) {
+        reportError("WARNING: Invalid parameter -- popDeque --\n");
+        return NULL;
+    }
+
+    DEQUE *dq = (DEQUE *) deque;
+
+    if(!dq->size) return NULL;
+
+    ListElement element = dq->elements[dq->first];
+
+    dq->first = (dq->first + 1) & (dq->capacity - 1);
+    dq->size--;
+
+    return element;
+}
+
+ListElement popEndDeque(Deque deque) {
+    if(PARAMETER_CHECK(!deque)) {
+        reportError("WARNING: Invalid parameter -- popEndDeque --\n");
+        return NULL;
+    }
+
+    DEQUE *dq = (DEQUE *) deque;
+
+    if(!dq->size) return NULL;
+
+    dq->size--;
+
+    return dq->elements[(dq->first + dq->size) & (dq->capacity - 1)];
+}
+
+ListElement getDequeElement(Deque deque, int position) {
+    if(PARAMETER_CHECK(!deque)) {
+        reportError("WARNING: Invalid parameter -- getDequeElement --\n");
+        return NULL;
+    }
+
+    DEQUE *dq = (DEQUE *) deque;
+
+    if(position < 0 || position >= dq->size) return NULL;
+
+    return dq->elements[(dq->first + position) & (dq->capacity - 1)];
+}
+
+ListElement setDequeElement(Deque deque, int position, ListElement element) {
+    if(PARAMETER_CHECK(!deque || !element)) {
+        reportError("WARNING: Invalid parameters -- setDequeElement --\n");
+        return NULL;
+    }
+
+    DEQUE *dq = (DEQUE *) deque;
+
+    if(position < 0 || position >= dq->size) return NULL;
+
+    ListElement *slot = &dq->elements[(dq->first + position) & (dq->capacity - 1)];
+    ListElement replaced = *slot;
+
+    *slot = element;
+
+    return replaced;
+}
+
+ListElement getFirstDequeElement(Deque deque) {
+    if(PARAMETER_CHECK(!deque)) {
+        reportError("WARNING: Invalid parameter -- getFirstDequeElement --\n");
+        return NULL;
+    }
+
+    return getDequeElement(deque, 0);
+}
+
+ListElement getLastDequeElement(Deque deque) {
+    if(PARAMETER_CHECK(!deque)) {
+        reportError("WARNING: Invalid parameter -- getLastDequeElement --\n");
+        return NULL;
+    }
+
+    return getDequeElement(deque, getDequeSize(deque) - 1);
+}
+
+void traverseDeque(Deque deque, VisitDequeElement visit, void *extra) {
+    if(PARAMETER_CHECK(!deque || !visit)) {
+        reportError("WARNING: Invalid parameters -- traverseDeque --\n");
+        return;
+    }
+
+    DEQUE *dq = (DEQUE *) deque;
+
+    // Walks the 2 contiguous pieces of the buffer instead of masking every position
+    int end = dq->capacity - dq->first;
+    int head = (dq->size < end) ? dq->size : end;
+
+    for(int i = 0; i < head; i++) {
+        if(visit(deque, dq->elements[dq->first + i], extra)) return;
+    }
+
+    for(int i = 0; i < dq->size - head; i++) {
+        if(visit(deque, dq->elements[i], extra)) return;
+    }
+}
+
+void destroyDeque(Deque deque) {
+    if(!deque) return;
+
+    DEQUE *dq = (DEQUE *) deque;
+
+    free(dq->elements);
+    free(dq);
+
+    deque = NULL;
+}
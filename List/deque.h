@@ -0,0 +1,204 @@
+#ifndef DEQUE_H
+#define DEQUE_H
+
+/*
+    - This module implements a double-ended queue(deque) backed by a ring buffer
+
+    - A deque stores its ListElements in a single array used as a circular buffer, elements are
+      inserted and removed at both ends in O(1), without allocating memory per element:
+        - When the array is full its capacity is doubled, so insertions are O(1) amortized
+        - The capacity is always a power of 2, positions are mapped to the array with a mask
+
+    - Each element has a position inside the deque, this position is inside the interval [0, deque.size)
+      and any element can be read in O(1) by its position
+
+    - Elements are contiguous in memory, except where the buffer wraps around, so traversals
+      touch one cache line per several elements
+
+    - A valid element is a ListElement != NULL
+
+    - In this module its assumed Deque != NULL and ListElement != NULL for functions that recieve
+      those as parameters
+
+    - Parameter checks are compiled out when DS_NO_CHECKS is defined (see Common/error.h)
+
+    - It's necessary to free the memory allocated for Deque using the functions provided in this module
+*/
+
+#include <limits.h>
+#include <stdbool.h>
+
+#include "list.h"
+
+// Capacity of the array of a new deque
+#define DEQUE_MIN_CAPACITY 16
+
+// Largest power of 2 that fits in an int, a deque never stores more elements
+#define DEQUE_MAX_CAPACITY (INT_MAX / 2 + 1)
+
+typedef void *Deque;
+
+/*
+    - Function utilized by traverseDeque
+
+    - If this function returns true, the traversal will stop
+*/
+typedef bool (* VisitDequeElement)(Deque deque, ListElement element, void *extra);
+
+/*
+    # Description:
+        - Returns a pointer to a new empty deque
+*/
+Deque newDeque();
+
+/*
+    # Input:
+        - deque: deque
+
+    # Description:
+        - Returns true if deque is empty, false otherwise
+*/
+bool isDequeEmpty(Deque deque);
+
+/*
+    # Input:
+        - deque: deque
+
+    # Description:
+        - Return the number of elements stored in deque
+*/
+int getDequeSize(Deque deque);
+
+/*
+    # Inputs:
+        - deque: deque
+        - capacity: Number of elements
+
+    # Description:
+        - Makes sure deque can store capacity elements without growing
+          its array again
+
+        - Returns false if capacity > DEQUE_MAX_CAPACITY or memory could not be allocated
+*/
+bool reserveDeque(Deque deque, int capacity);
+
+/*
+    # Inputs:
+        - deque: deque
+        - element: Element to be stored in deque
+
+    # Description:
+        - Insert element at the start of deque
+
+        - Returns false if element could not be inserted
+*/
+bool pushDeque(Deque deque, ListElement element);
+
+/*
+    # Inputs:
+        - deque: deque
+        - element: Element to be stored in deque
+
+    # Description:
+        - Insert element at the end of deque
+
+        - Returns false if element could not be inserted
+*/
+bool insertEndDeque(Deque deque, ListElement element);
+
+/*
+    # Input:
+        - deque: deque
+
+    # Description:
+        - Removes the first element from deque
+          and returns it
+
+        - Returns NULL if deque is empty
+*/
+ListElement popDeque(Deque deque);
+
+/*
+    # Input:
+        - deque: deque
+
+    # Description:
+        - Removes the last element from deque
+          and returns it
+
+        - Returns NULL if deque is empty
+*/
+ListElement popEndDeque(Deque deque);
+
+/*
+    # Input:
+        - deque: deque
+        - position: Position of the element
+
+    # Description:
+        - Returns the element stored at position, in O(1)
+
+        - If position is outside [0, deque.size), returns NULL
+*/
+ListElement getDequeElement(Deque deque, int position);
+
+/*
+    # Input:
+        - deque: deque
+        - position: Position of the element
+        - element: Element to be stored at position
+
+    # Description:
+        - Replaces the element stored at position by element
+          and returns the replaced element, in O(1)
+
+        - If position is outside [0, deque.size), returns NULL
+          and deque is not changed
+*/
+ListElement setDequeElement(Deque deque, int position, ListElement element);
+
+/*
+    # Input:
+        - deque: deque
+
+    # Description:
+        - Returns the first element from deque
+
+        - Returns NULL if deque is empty
+*/
+ListElement getFirstDequeElement(Deque deque);
+
+/*
+    # Input:
+        - deque: deque
+
+    # Description:
+        - Returns the last element from deque
+
+        - Returns NULL if deque is empty
+*/
+ListElement getLastDequeElement(Deque deque);
+
+/*
+    # Input:
+        - deque: deque
+        - visit: Function called for every element, from first to last
+        - extra: Extra pointer if necessary
+
+    # Description:
+        - Traverse deque in order
+
+        - extra can be NULL
+*/
+void traverseDeque(Deque deque, VisitDequeElement visit, void *extra);
+
+/*
+    # Input:
+        - deque: deque
+
+    # Description:
+        - Free all the memory used by deque
+*/
+void destroyDeque(Deque deque);
+
+#endif
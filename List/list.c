@@ -1,44 +1,76 @@
-#include <stdio.h>
 #include <stdlib.h>
 
-#include "list.h"
+#include "list_inline.h"
+#include "../Common/error.h"
 
-typedef struct listnode{
-    ListElement element;
-    struct listnode *previous, *next;
-}LISTNODE;
+List newList() {
+    return newListWithAllocator(NULL, NULL, NULL);
+}
 
-typedef struct {
-    int size;
-    LISTNODE *head, *tail;
-}LIST;
+List newListWithAllocator(AllocateMemory allocate, FreeMemory release, void *extra) {
+    if(PARAMETER_CHECK(!allocate != !release)) {
+        reportError("WARNING: Invalid parameters -- newListWithAllocator --\n");
+        return NULL;
+    }
 
-List newList() {
     LIST *dll = (LIST *) malloc(sizeof(LIST));
     if(!dll) {
-        printf("ERROR: Could not allocate memory for new list -- newList --\n");
+        reportError("ERROR: Could not allocate memory for new list -- newListWithAllocator --\n");
+        return NULL;
+    }
+
+    dll->pool = newPool(sizeof(LISTNODE), allocate, release, extra);
+    if(!dll->pool) {
+        reportError("ERROR: Could not allocate memory for new list -- newListWithAllocator --\n");
+        free(dll);
         return NULL;
     }
 
     dll->size = 0;
     dll->head = NULL;
     dll->tail = NULL;
+    dll->finger = NULL;
+    dll->fingerPosition = 0;
 
     return dll;
 }
 
-bool isListEmpty(List list) {
-    if(!list) {
-        printf("WARNING: Invalid parameter -- isListEmpty --\n");
+List newListSharedPool(List list) {
+    if(PARAMETER_CHECK(!list)) {
+        reportError("WARNING: Invalid parameter -- newListSharedPool --\n");
+        return NULL;
+    }
+
+    LIST *other = (LIST *) list;
+
+    LIST *dll = (LIST *) malloc(sizeof(LIST));
+    if(!dll) {
+        reportError("ERROR: Could not allocate memory for new list -- newListSharedPool --\n");
+        return NULL;
+    }
+
+    dll->pool = sharePool(other->pool);
+    dll->size = 0;
+    dll->head = NULL;
+    dll->tail = NULL;
+    dll->finger = NULL;
+    dll->fingerPosition = 0;
+
+    return dll;
+}
+
+bool (isListEmpty)(List list) {
+    if(PARAMETER_CHECK(!list)) {
+        reportError("WARNING: Invalid parameter -- isListEmpty --\n");
         return true;
     }
 
     return getListSize(list) == 0;
 }
 
-int getListSize(List list) {
-    if(!list) {
-        printf("WARNING: Invalid parameter -- getListSize --\n");
+int (getListSize)(List list) {
+    if(PARAMETER_CHECK(!list)) {
+        reportError("WARNING: Invalid parameter -- getListSize --\n");
         return 0;
     }
 
@@ -48,13 +80,16 @@ int getListSize(List list) {
 }
 
 /*
+    # Input:
+        - dll: List the node will belong to
+    
     # Description:
-        - Returns a pointer to a new list node
+        - Returns a pointer to a new list node allocated from the pool of dll
 */
-LISTNODE *newListNode() {
-    LISTNODE *lnd = (LISTNODE *) malloc(sizeof(LISTNODE));
+LISTNODE *newListNode(LIST *dll) {
+    LISTNODE *lnd = (LISTNODE *) allocatePool(dll->pool);
     if(!lnd) {
-        printf("ERROR: Could not allocate memory for new list node -- newListNode --\n");
+        reportError("ERROR: Could not allocate memory for new list node -- newListNode --\n");
         return NULL;
     }
 
@@ -66,18 +101,21 @@ LISTNODE *newListNode() {
 }
 
 ListNode pushList(List list, ListElement element) {
-    if(!list || !element) {
-        printf("WARNING: Invalid parameters -- pushList --\n");
+    if(PARAMETER_CHECK(!list || !element)) {
+        reportError("WARNING: Invalid parameters -- pushList --\n");
         return NULL;
     }
 
+    LIST *dll = (LIST *) list;
+
     // Create new node
-    LISTNODE *lnd = newListNode();
+    LISTNODE *lnd = newListNode(dll);
+    if(!lnd) return NULL;
+
     lnd->element = element;
-    lnd->next = getFirstListNode(list);
+    lnd->next = dll->head;
 
     // Adjust previous head pointer
-    LIST *dll = (LIST *) list;
     if(dll->head) dll->head->previous = lnd;
     dll->head = lnd;
 
@@ -86,13 +124,14 @@ ListNode pushList(List list, ListElement element) {
 
     // Update list size
     dll->size++;
+    if(dll->finger) dll->fingerPosition++;
 
     return lnd;
 }
 
 ListNode insertList(List list, ListElement element, int position) {
-    if(!list || !element) {
-        printf("WARNING: Invalid parameters -- insertList --\n");
+    if(PARAMETER_CHECK(!list || !element)) {
+        reportError("WARNING: Invalid parameters -- insertList --\n");
         return NULL;
     }
 
@@ -100,16 +139,15 @@ ListNode insertList(List list, ListElement element, int position) {
     if(position >= getListSize(list) || position < 0) return insertEndList(list, element);
 
     // Find node at position
-    ListNode node = getFirstListNode(list);
-    for(int i = 0; i < position; i++) node = getNextListNode(list, node);
+    ListNode node = getListNodeAt(list, position);
 
     // Place node
     return insertBeforeList(list, element, node);
 }
 
 ListNode insertAfterList(List list, ListElement element, ListNode node) {
-    if(!list || !element || !node) {
-        printf("WARNING: Invalid parameters -- insertAfterList --\n");
+    if(PARAMETER_CHECK(!list || !element || !node)) {
+        reportError("WARNING: Invalid parameters -- insertAfterList --\n");
         return NULL;
     }
 
@@ -118,7 +156,9 @@ ListNode insertAfterList(List list, ListElement element, ListNode node) {
 
     if(!lnd->next) return insertEndList(list, element);
 
-    LISTNODE *newNode = newListNode();
+    LISTNODE *newNode = newListNode(dll);
+    if(!newNode) return NULL;
+
     newNode->element = element;
 
     newNode->previous = lnd;
@@ -129,13 +169,14 @@ ListNode insertAfterList(List list, ListElement element, ListNode node) {
     lnd->next = newNode;
 
     dll->size++;
+    if(dll->finger != lnd) dll->finger = NULL;
 
     return newNode;
 }
 
 ListNode insertBeforeList(List list, ListElement element, ListNode node) {
-    if(!list || !element || !node) {
-        printf("WARNING: Invalid parameters -- insertBeforeList --\n");
+    if(PARAMETER_CHECK(!list || !element || !node)) {
+        reportError("WARNING: Invalid parameters -- insertBeforeList --\n");
         return NULL;
     }
 
@@ -144,7 +185,9 @@ ListNode insertBeforeList(List list, ListElement element, ListNode node) {
 
     if(!lnd->previous) return pushList(list, element);
 
-    LISTNODE *newNode = newListNode();
+    LISTNODE *newNode = newListNode(dll);
+    if(!newNode) return NULL;
+
     newNode->element = element;
 
     newNode->previous = lnd->previous;
@@ -155,13 +198,15 @@ ListNode insertBeforeList(List list, ListElement element, ListNode node) {
     lnd->previous = newNode;
 
     dll->size++;
+    if(dll->finger == lnd) dll->fingerPosition++;
+    else dll->finger = NULL;
 
     return newNode;
 }
 
 ListNode insertEndList(List list, ListElement element) {
-    if(!list || !element) {
-        printf("WARNING: Invalid parameters -- insertEndList --\n");
+    if(PARAMETER_CHECK(!list || !element)) {
+        reportError("WARNING: Invalid parameters -- insertEndList --\n");
         return NULL;
     }
 
@@ -169,7 +214,9 @@ ListNode insertEndList(List list, ListElement element) {
 
     LIST *dll = (LIST *) list;
 
-    LISTNODE *lnd = newListNode();
+    LISTNODE *lnd = newListNode(dll);
+    if(!lnd) return NULL;
+
     lnd->element = element;
     lnd->previous = dll->tail;
 
@@ -182,8 +229,8 @@ ListNode insertEndList(List list, ListElement element) {
 }
 
 ListElement pop(List list) {
-    if(!list) {
-        printf("WARNING: Invalid parameter -- pop --\n");
+    if(PARAMETER_CHECK(!list)) {
+        reportError("WARNING: Invalid parameter -- pop --\n");
         return NULL;
     }
 
@@ -196,20 +243,25 @@ ListElement pop(List list) {
 
     dll->head = dll->head->next;
     dll->size--;
+
+    if(!dll->head) dll->tail = NULL;
+
+    if(dll->finger == head) dll->finger = NULL;
+    else if(dll->finger) dll->fingerPosition--;
     
     if(!isListEmpty(list)) dll->head->previous = NULL;
     
     head->next = NULL;
     head->element = NULL;
 
-    free(head);
+    freePool(dll->pool, head);
 
     return element;
 }
 
 ListElement removeListNode(List list, ListNode node) {
-    if(!list || !node) {
-        printf("WARNING: Invalid parameters -- removeListNode --\n");
+    if(PARAMETER_CHECK(!list || !node)) {
+        reportError("WARNING: Invalid parameters -- removeListNode --\n");
         return NULL;
     }
 
@@ -221,6 +273,14 @@ ListElement removeListNode(List list, ListNode node) {
     if(!lnd->previous) return pop(list);
 
     ListElement element = lnd->element;
+
+    // Keep the finger on a neighbour when its node is removed, the position of any other node is unknown
+    if(dll->finger == lnd && lnd->next) dll->finger = lnd->next;
+    else if(dll->finger == lnd) {
+        dll->finger = lnd->previous;
+        dll->fingerPosition--;
+    }
+    else dll->finger = NULL;
     
     lnd->previous->next = lnd->next;
     if(lnd->next) lnd->next->previous = lnd->previous;
@@ -230,7 +290,7 @@ ListElement removeListNode(List list, ListNode node) {
     lnd->previous = NULL;
     lnd->element = NULL;
 
-    free(lnd);
+    freePool(dll->pool, lnd);
 
     dll->size--;
 
@@ -238,23 +298,55 @@ ListElement removeListNode(List list, ListNode node) {
 }
 
 ListElement removeList(List list, int position) {
-    if(!list) {
-        printf("WARNING: Invalid parameters -- removeList --\n");
+    if(PARAMETER_CHECK(!list)) {
+        reportError("WARNING: Invalid parameters -- removeList --\n");
         return NULL;
     }
 
     if(isListEmpty(list)) return NULL;
 
     // Find node at position
-    ListNode node = (position < 0) ? getLastListNode(list) : getFirstListNode(list);
-    for(int i = 0; i < position; i++) node = getNextListNode(list, node);
+    ListNode node = (position < 0 || position >= getListSize(list)) ? getLastListNode(list) : getListNodeAt(list, position);
 
     return removeListNode(list, node);
 }
 
-ListElement getListNodeElement(List list, ListNode node) {
-    if(!list || !node) {
-        printf("WARNING: Invalid parameters -- getListNodeElement --\n");
+ListNode getListNodeAt(List list, int position) {
+    if(PARAMETER_CHECK(!list)) {
+        reportError("WARNING: Invalid parameter -- getListNodeAt --\n");
+        return NULL;
+    }
+
+    LIST *dll = (LIST *) list;
+
+    if(position < 0 || position >= dll->size) return NULL;
+
+    // Start from the closest of head, tail and finger
+    LISTNODE *node = dll->head;
+    int current = 0;
+
+    if(dll->size - 1 - position < position) {
+        node = dll->tail;
+        current = dll->size - 1;
+    }
+
+    if(dll->finger && abs(dll->fingerPosition - position) < abs(current - position)) {
+        node = dll->finger;
+        current = dll->fingerPosition;
+    }
+
+    for(; current < position; current++) node = node->next;
+    for(; current > position; current--) node = node->previous;
+
+    dll->finger = node;
+    dll->fingerPosition = position;
+
+    return node;
+}
+
+ListElement (getListNodeElement)(List list, ListNode node) {
+    if(PARAMETER_CHECK(!list || !node)) {
+        reportError("WARNING: Invalid parameters -- getListNodeElement --\n");
         return NULL;
     }
 
@@ -263,35 +355,31 @@ ListElement getListNodeElement(List list, ListNode node) {
     return lnd->element;
 }
 
-ListNode getFirstListNode(List list) {
-    if(!list) {
-        printf("WARNING: Invalid parameter -- getFirstListNode --\n");
+ListNode (getFirstListNode)(List list) {
+    if(PARAMETER_CHECK(!list)) {
+        reportError("WARNING: Invalid parameter -- getFirstListNode --\n");
         return NULL;
     }
 
-    if(isListEmpty(list)) return NULL;
-
     LIST *dll = (LIST *) list;
 
     return dll->head;
 }
 
-ListNode getLastListNode(List list) {
-    if(!list) {
-        printf("WARNING: Invalid parameter -- getLastListNode --\n");
+ListNode (getLastListNode)(List list) {
+    if(PARAMETER_CHECK(!list)) {
+        reportError("WARNING: Invalid parameter -- getLastListNode --\n");
         return NULL;
     }
 
-    if(isListEmpty(list)) return NULL;
-
     LIST *dll = (LIST *) list;
 
     return dll->tail;
 }
 
-ListNode getNextListNode(List list, ListNode node) {
-    if(!list || !node) {
-        printf("WARNING: Invalid parameters -- getNextListNode --\n");
+ListNode (getNextListNode)(List list, ListNode node) {
+    if(PARAMETER_CHECK(!list || !node)) {
+        reportError("WARNING: Invalid parameters -- getNextListNode --\n");
         return NULL;
     }
 
@@ -300,9 +388,9 @@ ListNode getNextListNode(List list, ListNode node) {
     return lnd->next;
 }
 
-ListNode getPreviousListNode(List list, ListNode node) {
-    if(!list || !node) {
-        printf("WARNING: Invalid parameters -- getPreviousListNode --\n");
+ListNode (getPreviousListNode)(List list, ListNode node) {
+    if(PARAMETER_CHECK(!list || !node)) {
+        reportError("WARNING: Invalid parameters -- getPreviousListNode --\n");
         return NULL;
     }
 
@@ -312,8 +400,8 @@ ListNode getPreviousListNode(List list, ListNode node) {
 }
 
 void reverseList(List list) {
-    if(!list) {
-        printf("WARNING: Invalid parameter -- reverseList --\n");
+    if(PARAMETER_CHECK(!list)) {
+        reportError("WARNING: Invalid parameter -- reverseList --\n");
         return;
     }
 
@@ -321,6 +409,8 @@ void reverseList(List list) {
 
     LIST *dll = (LIST *) list;
 
+    if(dll->finger) dll->fingerPosition = dll->size - 1 - dll->fingerPosition;
+
     LISTNODE *currentNode = dll->head;
     dll->head = dll->tail;
     dll->tail = currentNode;
@@ -338,12 +428,431 @@ void reverseList(List list) {
     
 }
 
+/*
+    # Input:
+        - node: First node of a run, linked by next
+        - compare: Function to compare the elements
+    
+    # Description:
+        - Returns the last node of the ascending run that starts at node
+*/
+LISTNODE *getListRunEnd(LISTNODE *node, CompareElementsList compare) {
+    while(node->next && compare(node->element, node->next->element) <= 0) node = node->next;
+
+    return node;
+}
+
+/*
+    # Input:
+        - left: First run, ends with a NULL next
+        - leftEnd: Last node of left
+        - right: Second run, ends with a NULL next
+        - rightEnd: Last node of right
+        - compare: Function to compare the elements
+        - end: Where the last node of the merged run is stored
+    
+    # Description:
+        - Merges left and right, linked by next, and returns the first node
+          of the merged run
+
+        - Ties are taken from left, so the merge is stable
+*/
+LISTNODE *mergeListRuns(LISTNODE *left, LISTNODE *leftEnd, LISTNODE *right, LISTNODE *rightEnd, CompareElementsList compare, LISTNODE **end) {
+    LISTNODE *first = NULL;
+    LISTNODE **link = &first;
+
+    while(left && right) {
+        if(compare(right->element, left->element) < 0) {
+            *link = right;
+            right = right->next;
+        }
+        else {
+            *link = left;
+            left = left->next;
+        }
+
+        link = &(*link)->next;
+    }
+
+    // The rest of one of the runs is already in place
+    *link = (left) ? left : right;
+    *end = (left) ? leftEnd : rightEnd;
+
+    return first;
+}
+
+void sortList(List list, CompareElementsList compare) {
+    if(PARAMETER_CHECK(!list || !compare)) {
+        reportError("WARNING: Invalid parameters -- sortList --\n");
+        return;
+    }
+
+    LIST *dll = (LIST *) list;
+
+    if(dll->size < 2) return;
+
+    // Each pass merges pairs of consecutive runs, following only the next links,
+    // until a pass finds a single run
+    LISTNODE *head = dll->head;
+    bool merged = true;
+
+    while(merged) {
+        merged = false;
+
+        LISTNODE *rest = head;
+        LISTNODE **link = &head;
+
+        while(rest) {
+            LISTNODE *left = rest;
+            LISTNODE *leftEnd = getListRunEnd(left, compare);
+
+            LISTNODE *right = leftEnd->next;
+            if(!right) {
+                *link = left;
+                break;
+            }
+
+            LISTNODE *rightEnd = getListRunEnd(right, compare);
+            rest = rightEnd->next;
+
+            leftEnd->next = NULL;
+            rightEnd->next = NULL;
+
+            LISTNODE *end;
+            *link = mergeListRuns(left, leftEnd, right, rightEnd, compare, &end);
+            link = &end->next;
+            *link = rest;
+
+            merged = true;
+        }
+    }
+
+    // Restore the previous links
+    LISTNODE *previous = NULL;
+    for(LISTNODE *node = head; node; node = node->next) {
+        node->previous = previous;
+        previous = node;
+    }
+
+    dll->head = head;
+    dll->tail = previous;
+
+    // The position of the finger changed
+    dll->finger = NULL;
+}
+
+/*
+    # Input:
+        - dll: dll
+        - first: First node of the range
+        - last: Last node of the range, first or a node after it in dll
+    
+    # Description:
+        - Unlinks the nodes from first to last out of dll, they stay linked
+          to each other
+
+        - The size and the finger of dll are not updated
+*/
+void unlinkListRange(LIST *dll, LISTNODE *first, LISTNODE *last) {
+    if(first->previous) first->previous->next = last->next;
+    else dll->head = last->next;
+
+    if(last->next) last->next->previous = first->previous;
+    else dll->tail = first->previous;
+
+    first->previous = NULL;
+    last->next = NULL;
+}
+
+/*
+    # Input:
+        - dll: dll
+        - position: Node of dll the range is placed before, NULL for the end of dll
+        - first: First node of a range linked by next and previous
+        - last: Last node of the range
+    
+    # Description:
+        - Links the nodes from first to last into dll before position
+
+        - The size and the finger of dll are not updated
+*/
+void linkListRange(LIST *dll, LISTNODE *position, LISTNODE *first, LISTNODE *last) {
+    LISTNODE *previous = (position) ? position->previous : dll->tail;
+
+    first->previous = previous;
+    last->next = position;
+
+    if(previous) previous->next = first;
+    else dll->head = first;
+
+    if(position) position->previous = last;
+    else dll->tail = last;
+}
+
+/*
+    # Input:
+        - dst: List the nodes of src will be moved to
+        - src: List, != dst
+        - whole: If true, every node of src will be moved
+    
+    # Description:
+        - Makes the nodes of src belong to the pool of dst, so they can be relinked:
+            - Nothing to do if they share a pool
+            - The pool of src is merged into the pool of dst if possible (see mergePool),
+              or else the pool of dst into the pool of src
+            - The nodes left in the list whose pool was merged belong to the other pool now,
+              so that list shares it. If no node is left, it keeps its own empty pool
+
+        - Returns false, and changes nothing, if neither pool can be merged into the other
+          (different memory functions or both pools shared with other lists)
+*/
+bool adoptListNodes(LIST *dst, LIST *src, bool whole) {
+    if(dst->pool == src->pool) return true;
+
+    if(mergePool(dst->pool, src->pool)) {
+        if(!whole) {
+            destroyPool(src->pool);
+            src->pool = sharePool(dst->pool);
+        }
+
+        return true;
+    }
+
+    if(mergePool(src->pool, dst->pool)) {
+        if(whole) {
+            // src is left empty, it takes the emptied pool of dst
+            Pool pool = dst->pool;
+            dst->pool = src->pool;
+            src->pool = pool;
+        }
+        else {
+            destroyPool(dst->pool);
+            dst->pool = sharePool(src->pool);
+        }
+
+        return true;
+    }
+
+    return false;
+}
+
+/*
+    # Input:
+        - dst: List the nodes are moved to
+        - position: Node of dst the nodes are placed before, NULL for the end of dst
+        - src: List the nodes are taken from, its pool can't be merged with the pool of dst
+        - first: First node to be moved
+        - last: Last node to be moved, first or a node after it in src
+    
+    # Description:
+        - Moves the elements from first to last into new nodes of dst placed before
+          position and frees the nodes of src, used when the nodes can't be relinked
+          because their pool can't be merged with the pool of dst (see adoptListNodes)
+
+        - All the new nodes are allocated before src is changed, returns false and
+          leaves both lists unchanged if memory could not be allocated
+*/
+bool copyListRange(LIST *dst, LISTNODE *position, LIST *src, LISTNODE *first, LISTNODE *last) {
+    LISTNODE *copyFirst = NULL, *copyLast = NULL;
+    int count = 0;
+
+    for(LISTNODE *node = first; ; node = node->next) {
+        LISTNODE *copy = newListNode(dst);
+        if(!copy) {
+            while(copyFirst) {
+                LISTNODE *next = copyFirst->next;
+                freePool(dst->pool, copyFirst);
+                copyFirst = next;
+            }
+
+            return false;
+        }
+
+        copy->element = node->element;
+        copy->previous = copyLast;
+
+        if(copyLast) copyLast->next = copy;
+        else copyFirst = copy;
+
+        copyLast = copy;
+        count++;
+
+        if(node == last) break;
+    }
+
+    unlinkListRange(src, first, last);
+
+    for(LISTNODE *node = first, *next; node; node = next) {
+        next = node->next;
+        freePool(src->pool, node);
+    }
+
+    linkListRange(dst, position, copyFirst, copyLast);
+
+    src->size -= count;
+    dst->size += count;
+
+    // The positions of the nodes changed
+    src->finger = NULL;
+    dst->finger = NULL;
+
+    return true;
+}
+
+/*
+    # Input:
+        - dst: List the nodes are moved to
+        - position: Node of dst the nodes are placed before, NULL for the end of dst
+        - src: List the nodes are taken from, its nodes belong to the pool of dst
+        - first: First node to be moved
+        - last: Last node to be moved, first or a node after it in src
+        - count: Number of nodes from first to last
+    
+    # Description:
+        - Moves the nodes from first to last before position in dst, in O(1)
+*/
+void relinkListRange(LIST *dst, LISTNODE *position, LIST *src, LISTNODE *first, LISTNODE *last, int count) {
+    unlinkListRange(src, first, last);
+    linkListRange(dst, position, first, last);
+
+    src->size -= count;
+    dst->size += count;
+
+    // The positions of the nodes changed
+    src->finger = NULL;
+    dst->finger = NULL;
+}
+
+bool spliceList(List list, ListNode position, List other, ListNode first, ListNode last) {
+    if(PARAMETER_CHECK(!list || !other || !first || !last)) {
+        reportError("WARNING: Invalid parameters -- spliceList --\n");
+        return false;
+    }
+
+    LIST *dst = (LIST *) list;
+    LIST *src = (LIST *) other;
+    LISTNODE *pos = (LISTNODE *) position;
+    LISTNODE *fst = (LISTNODE *) first;
+    LISTNODE *lst = (LISTNODE *) last;
+
+    if(dst == src) {
+        // The nodes are already before position
+        if(pos == fst || pos == lst->next) return true;
+
+        relinkListRange(dst, pos, src, fst, lst, 0);
+
+        return true;
+    }
+
+    // Only the size of the lists requires walking the moved nodes
+    int count = 1;
+    for(LISTNODE *node = fst; node != lst; node = node->next) {
+        if(PARAMETER_CHECK(!node->next)) {
+            reportError("WARNING: last is not after first -- spliceList --\n");
+            return false;
+        }
+
+        count++;
+    }
+
+    if(!adoptListNodes(dst, src, count == src->size)) return copyListRange(dst, pos, src, fst, lst);
+
+    relinkListRange(dst, pos, src, fst, lst, count);
+
+    return true;
+}
+
+bool concatList(List list, List other) {
+    if(PARAMETER_CHECK(!list || !other || list == other)) {
+        reportError("WARNING: Invalid parameters -- concatList --\n");
+        return false;
+    }
+
+    LIST *dst = (LIST *) list;
+    LIST *src = (LIST *) other;
+
+    if(!src->size) return true;
+
+    if(!adoptListNodes(dst, src, true)) return copyListRange(dst, NULL, src, src->head, src->tail);
+
+    relinkListRange(dst, NULL, src, src->head, src->tail, src->size);
+
+    return true;
+}
+
+List splitList(List list, ListNode node) {
+    if(PARAMETER_CHECK(!list || !node)) {
+        reportError("WARNING: Invalid parameters -- splitList --\n");
+        return NULL;
+    }
+
+    LIST *dll = (LIST *) list;
+    LISTNODE *lnd = (LISTNODE *) node;
+
+    LIST *split = (LIST *) newListSharedPool(list);
+    if(!split) return NULL;
+
+    // Walk from node to the tail and from the head to node at the same time,
+    // the walk that finishes first gives the number of moved nodes
+    LISTNODE *forward = lnd, *fromHead = dll->head;
+    int steps = 0;
+
+    while(forward && fromHead != lnd) {
+        forward = forward->next;
+        fromHead = fromHead->next;
+        steps++;
+    }
+
+    int count = (forward) ? dll->size - steps : steps;
+
+    relinkListRange(split, NULL, dll, lnd, dll->tail, count);
+
+    return split;
+}
+
 void destroyList(List list) {
     if(!list) return;
 
-    while(!isListEmpty(list)) removeListNode(list, getFirstListNode(list));
+    LIST *dll = (LIST *) list;
+
+    // Nodes are dropped with the slabs of the pool instead of one by one,
+    // unless other lists still use the pool
+    if(isPoolShared(dll->pool)) {
+        for(LISTNODE *node = dll->head, *next; node; node = next) {
+            next = node->next;
+            freePool(dll->pool, node);
+        }
+    }
+
+    destroyPool(dll->pool);
+
+    free(dll);
+
+    list = NULL;
+}
+
+void destroyListAndElements(List list, DestroyListElement destroy) {
+    if(!list) return;
+
+    if(PARAMETER_CHECK(!destroy)) {
+        reportError("WARNING: Invalid parameter -- destroyListAndElements --\n");
+        return;
+    }
+
+    LIST *dll = (LIST *) list;
+    bool shared = isPoolShared(dll->pool);
+
+    // Nodes only need to be freed one by one while other lists use the pool
+    for(LISTNODE *node = dll->head, *next; node; node = next) {
+        next = node->next;
+
+        destroy(node->element);
+        if(shared) freePool(dll->pool, node);
+    }
+
+    destroyPool(dll->pool);
 
-    free(list);
+    free(dll);
 
     list = NULL;
 }
@@ -16,21 +16,77 @@
     - In this module its assumed List != NULL, ListElement != NULL and ListNode != NULL for functions that recieve
       those as parameters 
 
+    - Parameter checks are compiled out when DS_NO_CHECKS is defined (see Common/error.h)
+
+    - ListNodes are allocated from a node pool owned by the List, the memory for the pool can come
+      from user supplied functions (see newListWithAllocator)
+
+    - ListNodes are moved between lists by relinking, without freeing or allocating memory
+      (see spliceList, concatList and splitList). The pool of the list the nodes come from is
+      merged into the pool of the list they go to, lists that still hold nodes of the same pool
+      then share it (see newListSharedPool)
+
     - It's necessary to free the memory allocated for List and ListNode using the functions provided in this module
 */
 
 #include <stdbool.h>
 
+#include "../Pool/pool.h"
+
 typedef void *List;
 typedef void *ListElement;
 typedef void *ListNode;
 
+/*
+    - Function to compare 2 ListElements
+
+    - Returns: < 0 if el1 < el2
+             > 0 if el1 > el2
+             0 if el1 == el2
+*/
+typedef int (* CompareElementsList)(ListElement el1, ListElement el2);
+
+/*
+    - Function utilized by destroyListAndElements to free a ListElement
+*/
+typedef void (* DestroyListElement)(ListElement element);
+
 /*
     # Description:
         - Returns a pointer to a new empty list
 */
 List newList();
 
+/*
+    # Input:
+        - allocate: Function used to allocate memory for the nodes of the list
+        - release: Function used to free memory allocated by allocate
+        - extra: Extra pointer given to allocate and release if necessary
+    
+    # Description:
+        - Returns a pointer to a new empty list whose nodes are allocated
+          in slabs obtained from allocate
+
+        - allocate and release must be both NULL or both != NULL,
+          if both are NULL malloc and free are used
+*/
+List newListWithAllocator(AllocateMemory allocate, FreeMemory release, void *extra);
+
+/*
+    # Input:
+        - list: dll
+    
+    # Description:
+        - Returns a pointer to a new empty list whose nodes are allocated
+          from the same pool as the nodes of list
+
+        - The pool is freed when the last list using it is destroyed, while
+          it's shared destroyList frees the nodes of a list one by one
+
+        - Lists sharing a pool can't be used at the same time from different threads
+*/
+List newListSharedPool(List list);
+
 /*
     # Input:
         - list: dll
@@ -74,6 +130,8 @@ ListNode pushList(List list, ListElement element);
           the element will be positioned at the end
           of the list
 
+        - The node at position is found as in getListNodeAt
+
         - Returns a pointer to the node created for element
 */
 ListNode insertList(List list, ListElement element, int position);
@@ -149,15 +207,33 @@ ListElement removeListNode(List list, ListNode node);
     # Description:
         - Remove element at informed position
 
-        - If position > list.size or position == -1, 
+        - If position >= list.size or position == -1, 
           the last element from list will be removed
 
+        - The node at position is found as in getListNodeAt
+
         - Returns the removed element
 
         - List cannot be empty
 */
 ListElement removeList(List list, int position);
 
+/*
+    # Input:
+        - list: dll
+        - position: Position of the node
+    
+    # Description:
+        - Returns the ListNode at position
+
+        - The walk starts from the closest of the first node, the last node
+          and the node of the previous positional access, so accesses near
+          either end or near the previous position are fast
+
+        - If position < 0 or position >= list.size, returns NULL
+*/
+ListNode getListNodeAt(List list, int position);
+
 /*
     # Input:
         - list: dll
@@ -227,6 +303,94 @@ ListNode getPreviousListNode(List list, ListNode node);
 */
 void reverseList(List list);
 
+/*
+    # Input:
+        - list: dll
+        - compare: Function to compare the elements of list
+    
+    # Description:
+        - Sorts list in ascending order with a bottom-up merge sort, in O(n log n)
+
+        - The sort is stable, equal elements keep their order
+
+        - The nodes are relinked, each ListNode keeps its element and stays valid,
+          and no memory is allocated
+
+        - Ascending runs already in list are merged as they are, a sorted list is
+          checked in a single pass and a nearly sorted one takes few passes
+
+        - Ex: If list = [3, 1, 4, 1, 5] list will be: [1, 1, 3, 4, 5]
+*/
+void sortList(List list, CompareElementsList compare);
+
+/*
+    # Input:
+        - list: dll the nodes are moved to
+        - position: Node of list the nodes are placed before, NULL for the end of list
+        - other: dll the nodes are taken from, can be list
+        - first: First node to be moved
+        - last: Last node to be moved, first or a node after it in other
+    
+    # Description:
+        - Moves the nodes from first to last out of other and places them
+          before position in list
+
+        - The nodes are relinked, each ListNode keeps its element and stays valid:
+            - O(1) if list is other, position must not be one of the moved nodes
+            - Otherwise the moved nodes are counted to update the sizes, but their
+              elements are not touched and no memory is allocated or freed
+            - If list and other don't share a pool, one pool is merged into the other
+              (see mergePool). Unless other is left empty, list and other then share it
+              and can't be used at the same time from different threads
+
+        - Only if the pools can't be merged (lists made with different memory functions,
+          or both pools already shared with other lists) the elements are moved to new
+          nodes of list and the moved ListNodes are freed
+
+        - Returns false if memory could not be allocated, both lists are then unchanged
+
+        - Ex: If list = [1, 2, 3], other = [4, 5, 6, 7] and position, first and last
+              are the nodes of 2, 5 and 6, list will be: [1, 5, 6, 2, 3] and other: [4, 7]
+*/
+bool spliceList(List list, ListNode position, List other, ListNode first, ListNode last);
+
+/*
+    # Input:
+        - list: dll
+        - other: dll, != list
+    
+    # Description:
+        - Moves every node of other to the end of list, other is left empty
+
+        - The nodes are relinked as in spliceList, each ListNode keeps its element
+          and stays valid. O(1) if list and other share a pool, otherwise the cost of
+          merging the pools depends on their number of slabs and freed nodes
+
+        - Returns false if memory could not be allocated, both lists are then unchanged
+
+        - Ex: If list = [1, 2] and other = [3, 4], list will be: [1, 2, 3, 4] and other: []
+*/
+bool concatList(List list, List other);
+
+/*
+    # Input:
+        - list: dll
+        - node: Node of list
+    
+    # Description:
+        - Moves node and every node after it to a new list, that shares
+          the pool of list, and returns the new list
+
+        - Each ListNode keeps its element and stays valid, the cost is the
+          number of nodes on the shorter side of node
+
+        - Returns NULL if memory could not be allocated, list is then unchanged
+
+        - Ex: If list = [1, 2, 3, 4] and node is the node of 3, list will be: [1, 2]
+              and the new list: [3, 4]
+*/
+List splitList(List list, ListNode node);
+
 /*
     # Input:
         - list: dll
@@ -236,4 +400,21 @@ void reverseList(List list);
 */
 void destroyList(List list);
 
+/*
+    # Input:
+        - list: dll
+        - destroy: Function called for every element of list
+    
+    # Description:
+        - Calls destroy for every element of list and frees all the memory
+          used by list, in a single O(n) walk
+
+        - Ex: destroyListAndElements(list, free) frees elements allocated with malloc
+*/
+void destroyListAndElements(List list, DestroyListElement destroy);
+
+#ifdef DS_NO_CHECKS
+#include "list_inline.h"
+#endif
+
 #endif
\ No newline at end of file
@@ -0,0 +1,291 @@
+#ifndef LIST_GENERIC_H
+#define LIST_GENERIC_H
+
+/*
+    - This module generates doubly linked lists(dll) that store values of a given type inside
+      their nodes, instead of a ListElement pointing to memory allocated elsewhere
+
+    - DEFINE_LIST(name, T) defines, for a dll named name storing values of type T:
+        - The types name and name##Node, their fields can be read directly:
+            - name: size, head, tail
+            - name##Node: value, next, previous
+        - The functions below, with the same algorithms as list.c (ex: for DEFINE_LIST(IntList, int),
+          newIntList, pushIntList, popIntList, ...)
+
+    - The functions are static inline, DEFINE_LIST can be used in several translation units,
+      each one gets its own copy of the functions the compiler doesn't inline
+
+    - T can be any type that can be assigned, values are copied in and out of the nodes
+
+    - Nodes are allocated from a node pool owned by the list (see pool.h)
+
+    - Parameter checks are compiled out when DS_NO_CHECKS is defined (see Common/error.h)
+
+    - In this module its assumed name * != NULL and name##Node * != NULL for functions that recieve
+      those as parameters
+
+    - It's necessary to free the memory allocated for the lists using the functions generated by DEFINE_LIST
+
+    - Generated functions:
+        - name *new##name(): Returns a pointer to a new empty list
+
+        - bool is##name##Empty(name *list): Returns true if list is empty
+
+        - int get##name##Size(name *list): Returns the number of values stored in list
+
+        - name##Node *push##name(name *list, T value): Inserts value at the start of list and returns
+          its node, returns NULL if value could not be inserted
+
+        - name##Node *insertEnd##name(name *list, T value): Same as push##name, at the end of list
+
+        - name##Node *insertAfter##name(name *list, T value, name##Node *node): Same as push##name,
+          after node
+
+        - name##Node *insertBefore##name(name *list, T value, name##Node *node): Same as push##name,
+          before node
+
+        - bool pop##name(name *list, T *value): Removes the first value of list and stores it in value,
+          returns false if list is empty. value can be NULL
+
+        - bool popEnd##name(name *list, T *value): Same as pop##name, with the last value of list
+
+        - T remove##name##Node(name *list, name##Node *node): Removes node from list and returns its value,
+          returns a T with every byte set to 0 if the parameters are invalid
+
+        - name##Node *get##name##NodeAt(name *list, int position): Returns the node at position,
+          NULL if position is outside [0, size). Walks from the closest end of list
+
+        - void reverse##name(name *list): Reverses list
+
+        - void destroy##name(name *list): Free all the memory used by list
+
+    - Ex:
+        DEFINE_LIST(PointList, struct point)
+
+        PointList *points = newPointList();
+        insertEndPointList(points, (struct point) {1, 2});
+        for(PointListNode *node = points->head; node; node = node->next) draw(node->value);
+        destroyPointList(points);
+*/
+
+#include <stdbool.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "../Pool/pool.h"
+#include "../Common/error.h"
+
+#define DEFINE_LIST(name, T)                                                                            \
+                                                                                                        \
+typedef struct name##Node {                                                                             \
+    T value;                                                                                            \
+    struct name##Node *next, *previous;                                                                 \
+}name##Node;                                                                                            \
+                                                                                                        \
+typedef struct {                                                                                        \
+    int size;                                                                                           \
+    name##Node *head, *tail;                                                                            \
+    Pool pool;                                                                                          \
+}name;                                                                                                  \
+                                                                                                        \
+static inline name *new##name() {                                                                       \
+    name *list = (name *) malloc(sizeof(name));                                                         \
+    if(!list) {                                                                                         \
+        reportError("ERROR: Could not allocate memory for new list -- new" #name " --\n");              \
+        return NULL;                                                                                    \
+    }                                                                                                   \
+                                                                                                        \
+    list->pool = newPool(sizeof(name##Node), NULL, NULL, NULL);                                         \
+    if(!list->pool) {                                                                                   \
+        reportError("ERROR: Could not allocate memory for new list -- new" #name " --\n");              \
+        free(list);                                                                                     \
+        return NULL;                                                                                    \
+    }                                                                                                   \
+                                                                                                        \
+    list->size = 0;                                                                                     \
+    list->head = NULL;                                                                                  \
+    list->tail = NULL;                                                                                  \
+                                                                                                        \
+    return list;                                                                                        \
+}                                                                                                       \
+                                                                                                        \
+static inline bool is##name##Empty(name *list) {                                                        \
+    if(PARAMETER_CHECK(!list)) {                                                                        \
+        reportError("WARNING: Invalid parameter -- is" #name "Empty --\n");                             \
+        return true;                                                                                    \
+    }                                                                                                   \
+                                                                                                        \
+    return list->size == 0;                                                                             \
+}                                                                                                       \
+                                                                                                        \
+static inline int get##name##Size(name *list) {                                                         \
+    if(PARAMETER_CHECK(!list)) {                                                                        \
+        reportError("WARNING: Invalid parameter -- get" #name "Size --\n");                             \
+        return 0;                                                                                       \
+    }                                                                                                   \
+                                                                                                        \
+    return list->size;                                                                                  \
+}                                                                                                       \
+                                                                                                        \
+/* Links a new node with value between previous and next, either can be NULL */                         \
+static inline name##Node *link##name##Node(name *list, T value,                                         \
+                                           name##Node *previous, name##Node *next) {                    \
+    name##Node *node = (name##Node *) allocatePool(list->pool);                                         \
+    if(!node) {                                                                                         \
+        reportError("ERROR: Could not allocate memory for new list node -- link" #name "Node --\n");    \
+        return NULL;                                                                                    \
+    }                                                                                                   \
+                                                                                                        \
+    node->value = value;                                                                                \
+    node->previous = previous;                                                                          \
+    node->next = next;                                                                                  \
+                                                                                                        \
+    if(previous) previous->next = node;                                                                 \
+    else list->head = node;                                                                             \
+                                                                                                        \
+    if(next) next->previous = node;                                                                     \
+    else list->tail = node;                                                                             \
+                                                                                                        \
+    list->size++;                                                                                       \
+                                                                                                        \
+    return node;                                                                                        \
+}                                                                                                       \
+                                                                                                        \
+static inline name##Node *push##name(name *list, T value) {                                             \
+    if(PARAMETER_CHECK(!list)) {                                                                        \
+        reportError("WARNING: Invalid parameter -- push" #name " --\n");                                \
+        return NULL;                                                                                    \
+    }                                                                                                   \
+                                                                                                        \
+    return link##name##Node(list, value, NULL, list->head);                                             \
+}                                                                                                       \
+                                                                                                        \
+static inline name##Node *insertEnd##name(name *list, T value) {                                        \
+    if(PARAMETER_CHECK(!list)) {                                                                        \
+        reportError("WARNING: Invalid parameter -- insertEnd" #name " --\n");                           \
+        return NULL;                                                                                    \
+    }                                                                                                   \
+                                                                                                        \
+    return link##name##Node(list, value, list->tail, NULL);                                             \
+}                                                                                                       \
+                                                                                                        \
+static inline name##Node *insertAfter##name(name *list, T value, name##Node *node) {                    \
+    if(PARAMETER_CHECK(!list || !node)) {                                                               \
+        reportError("WARNING: Invalid parameters -- insertAfter" #name " --\n");                        \
+        return NULL;                                                                                    \
+    }                                                                                                   \
+                                                                                                        \
+    return link##name##Node(list, value, node, node->next);                                             \
+}                                                                                                       \
+                                                                                                        \
+static inline name##Node *insertBefore##name(name *list, T value, name##Node *node) {                   \
+    if(PARAMETER_CHECK(!list || !node)) {                                                               \
+        reportError("WARNING: Invalid parameters -- insertBefore" #name " --\n");                       \
+        return NULL;                                                                                    \
+    }                                                                                                   \
+                                                                                                        \
+    return link##name##Node(list, value, node->previous, node);                                         \
+}                                                                                                       \
+                                                                                                        \
+static inline T remove##name##Node(name *list, name##Node *node) {                                      \
+    if(PARAMETER_CHECK(!list || !node)) {                                                               \
+        reportError("WARNING: Invalid parameters -- remove" #name "Node --\n");                         \
+                                                                                                        \
+        T zero;                                                                                         \
+        memset(&zero, 0, sizeof(zero));                                                                 \
+                                                                                                        \
+        return zero;                                                                                    \
+    }                                                                                                   \
+                                                                                                        \
+    if(node->previous) node->previous->next = node->next;                                               \
+    else list->head = node->next;                                                                       \
+                                                                                                        \
+    if(node->next) node->next->previous = node->previous;                                               \
+    else list->tail = node->previous;                                                                   \
+                                                                                                        \
+    T value = node->value;                                                                              \
+                                                                                                        \
+    freePool(list->pool, node);                                                                         \
+    list->size--;                                                                                       \
+                                                                                                        \
+    return value;                                                                                       \
+}                                                                                                       \
+                                                                                                        \
+static inline bool pop##name(name *list, T *value) {                                                    \
+    if(PARAMETER_CHECK(!list)) {                                                                        \
+        reportError("WARNING: Invalid parameter -- pop" #name " --\n");                                 \
+        return false;                                                                                   \
+    }                                                                                                   \
+                                                                                                        \
+    if(!list->head) return false;                                                                       \
+                                                                                                        \
+    T removed = remove##name##Node(list, list->head);                                                   \
+    if(value) *value = removed;                                                                         \
+                                                                                                        \
+    return true;                                                                                        \
+}                                                                                                       \
+                                                                                                        \
+static inline bool popEnd##name(name *list, T *value) {                                                 \
+    if(PARAMETER_CHECK(!list)) {                                                                        \
+        reportError("WARNING: Invalid parameter -- popEnd" #name " --\n");                              \
+        return false;                                                                                   \
+    }                                                                                                   \
+                                                                                                        \
+    if(!list->tail) return false;                                                                       \
+                                                                                                        \
+    T removed = remove##name##Node(list, list->tail);                                                   \
+    if(value) *value = removed;                                                                         \
+                                                                                                        \
+    return true;                                                                                        \
+}                                                                                                       \
+                                                                                                        \
+static inline name##Node *get##name##NodeAt(name *list, int position) {                                 \
+    if(PARAMETER_CHECK(!list)) {                                                                        \
+        reportError("WARNING: Invalid parameter -- get" #name "NodeAt --\n");                           \
+        return NULL;                                                                                    \
+    }                                                                                                   \
+                                                                                                        \
+    if(position < 0 || position >= list->size) return NULL;                                             \
+                                                                                                        \
+    name##Node *node;                                                                                   \
+    if(position < list->size / 2) {                                                                     \
+        for(node = list->head; position > 0; position--) node = node->next;                             \
+    }                                                                                                   \
+    else {                                                                                              \
+        for(node = list->tail, position = list->size - 1 - position; position > 0; position--)          \
+            node = node->previous;                                                                      \
+    }                                                                                                   \
+                                                                                                        \
+    return node;                                                                                        \
+}                                                                                                       \
+                                                                                                        \
+static inline void reverse##name(name *list) {                                                          \
+    if(PARAMETER_CHECK(!list)) {                                                                        \
+        reportError("WARNING: Invalid parameter -- reverse" #name " --\n");                             \
+        return;                                                                                         \
+    }                                                                                                   \
+                                                                                                        \
+    name##Node *node = list->head;                                                                      \
+    list->head = list->tail;                                                                            \
+    list->tail = node;                                                                                  \
+                                                                                                        \
+    while(node) {                                                                                       \
+        name##Node *next = node->next;                                                                  \
+                                                                                                        \
+        node->next = node->previous;                                                                    \
+        node->previous = next;                                                                          \
+                                                                                                        \
+        node = next;                                                                                    \
+    }                                                                                                   \
+}                                                                                                       \
+                                                                                                        \
+static inline void destroy##name(name *list) {                                                          \
+    if(!list) return;                                                                                   \
+                                                                                                        \
+    /* Nodes are dropped with the slabs of the pool instead of one by one */                            \
+    destroyPool(list->pool);                                                                            \
+                                                                                                        \
+    free(list);                                                                                         \
+}
+
+#endif
@@ -0,0 +1,76 @@
+#ifndef LIST_INLINE_H
+#define LIST_INLINE_H
+
+/*
+    - Memory layout of the List module and inline versions of its trivial accessors
+
+    - list.h includes this header when DS_NO_CHECKS is defined, the accessors are then replaced
+      by the inline versions, which don't check their parameters and can be inlined in the
+      caller's loops
+
+    - list.c wraps the names of the replaced accessors in parentheses, so their out of line
+      definitions are still compiled
+*/
+
+#include "list.h"
+
+typedef struct listnode{
+    ListElement element;
+    struct listnode *previous, *next;
+}LISTNODE;
+
+typedef struct {
+    int size;
+    LISTNODE *head, *tail;
+    Pool pool;
+
+    // Last node reached by position and its position, positional walks can start from it
+    LISTNODE *finger;
+    int fingerPosition;
+}LIST;
+
+static inline bool isListEmptyInline(List list) {
+    return ((LIST *) list)->size == 0;
+}
+
+static inline int getListSizeInline(List list) {
+    return ((LIST *) list)->size;
+}
+
+static inline ListElement getListNodeElementInline(List list, ListNode node) {
+    (void) list;
+
+    return ((LISTNODE *) node)->element;
+}
+
+static inline ListNode getFirstListNodeInline(List list) {
+    return ((LIST *) list)->head;
+}
+
+static inline ListNode getLastListNodeInline(List list) {
+    return ((LIST *) list)->tail;
+}
+
+static inline ListNode getNextListNodeInline(List list, ListNode node) {
+    (void) list;
+
+    return ((LISTNODE *) node)->next;
+}
+
+static inline ListNode getPreviousListNodeInline(List list, ListNode node) {
+    (void) list;
+
+    return ((LISTNODE *) node)->previous;
+}
+
+#ifdef DS_NO_CHECKS
+#define isListEmpty(list) isListEmptyInline(list)
+#define getListSize(list) getListSizeInline(list)
+#define getListNodeElement(list, node) getListNodeElementInline(list, node)
+#define getFirstListNode(list) getFirstListNodeInline(list)
+#define getLastListNode(list) getLastListNodeInline(list)
+#define getNextListNode(list, node) getNextListNodeInline(list, node)
+#define getPreviousListNode(list, node) getPreviousListNodeInline(list, node)
+#endif
+
+#endif
@@ -0,0 +1,237 @@
+#define _POSIX_C_SOURCE 200809L
+
+// off_t holds offsets past 2 GiB on 32-bit systems too
+#define _FILE_OFFSET_BITS 64
+
+#include <fcntl.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "list_mmap.h"
+#include "../Common/error.h"
+
+#define LIST_MAP_MAGIC "DSLSTMAP"
+#define LIST_MAP_VERSION 1
+
+// Element bytes start at multiples of this alignment
+#define LIST_MAP_ALIGNMENT 8
+
+#define LIST_MAP_ALIGN(size) (((size) + LIST_MAP_ALIGNMENT - 1) / LIST_MAP_ALIGNMENT * LIST_MAP_ALIGNMENT)
+
+typedef struct {
+    char magic[8];
+    uint32_t version, entrySize;
+    int32_t size, reserved;
+
+    // Offset of the entry array and size of the file, in bytes
+    uint64_t entries, length;
+}LISTMAPHEADER;
+
+typedef struct {
+    // Offset of the element bytes from the start of the file and their number
+    uint64_t element, elementSize;
+}LISTMAPENTRY;
+
+typedef struct {
+    char *base;
+    size_t length;
+    const LISTMAPHEADER *header;
+    const LISTMAPENTRY *entries;
+}MAPPEDLIST;
+
+/*
+    # Input:
+        - mapped: MappedList
+        - entry: Entry of mapped
+
+    # Description:
+        - Returns true if the element bytes of entry are inside the file
+*/
+bool isListMapEntryValid(const MAPPEDLIST *mapped, const LISTMAPENTRY *entry) {
+    return entry->element <= mapped->length && entry->elementSize <= mapped->length - entry->element;
+}
+
+bool saveList(List list, const char *path, SerializeListElement serialize, void *extra) {
+    if(PARAMETER_CHECK(!list || !path || !serialize)) {
+        reportError("WARNING: Invalid parameters -- saveList --\n");
+        return false;
+    }
+
+    int size = getListSize(list);
+
+    LISTMAPENTRY *entries = (LISTMAPENTRY *) malloc((size > 0 ? size : 1) * sizeof(LISTMAPENTRY));
+    if(!entries) {
+        reportError("ERROR: Could not allocate memory for list entries -- saveList --\n");
+        return false;
+    }
+
+    FILE *file = fopen(path, "wb");
+    if(!file) {
+        reportError("ERROR: Could not open file -- saveList --\n");
+        free(entries);
+        return false;
+    }
+
+    // The element bytes are written after the space of the header and the entries,
+    // which are written once the offsets are known
+    LISTMAPHEADER header = {LIST_MAP_MAGIC, LIST_MAP_VERSION, sizeof(LISTMAPENTRY), size, 0, sizeof(LISTMAPHEADER), 0};
+    uint64_t offset = sizeof(LISTMAPHEADER) + (uint64_t) size * sizeof(LISTMAPENTRY);
+
+    static const char padding[LIST_MAP_ALIGNMENT] = {0};
+    bool ok = fseeko(file, (off_t) offset, SEEK_SET) == 0;
+
+    int i = 0;
+    for(ListNode node = getFirstListNode(list); ok && node; node = getNextListNode(list, node), i++) {
+        size_t elementSize;
+        const void *bytes = serialize(getListNodeElement(list, node), &elementSize, extra);
+
+        size_t aligned = LIST_MAP_ALIGN(elementSize);
+
+        ok = bytes && fwrite(bytes, 1, elementSize, file) == elementSize &&
+             fwrite(padding, 1, aligned - elementSize, file) == aligned - elementSize;
+
+        entries[i].element = offset;
+        entries[i].elementSize = elementSize;
+        offset += aligned;
+    }
+
+    if(ok) {
+        header.length = offset;
+
+        ok = fseeko(file, 0, SEEK_SET) == 0 && fwrite(&header, sizeof(LISTMAPHEADER), 1, file) == 1 &&
+             fwrite(entries, sizeof(LISTMAPENTRY), size, file) == (size_t) size;
+    }
+
+    ok = (fclose(file) == 0) && ok;
+    free(entries);
+
+    if(!ok) {
+        reportError("ERROR: Could not write file -- saveList --\n");
+        remove(path);
+    }
+
+    return ok;
+}
+
+MappedList mmapList(const char *path) {
+    if(PARAMETER_CHECK(!path)) {
+        reportError("WARNING: Invalid parameter -- mmapList --\n");
+        return NULL;
+    }
+
+    int fd = open(path, O_RDONLY);
+    if(fd < 0) {
+        reportError("ERROR: Could not open file -- mmapList --\n");
+        return NULL;
+    }
+
+    struct stat status;
+    if(fstat(fd, &status) != 0 || (uintmax_t) status.st_size > SIZE_MAX || (size_t) status.st_size < sizeof(LISTMAPHEADER)) {
+        reportError("WARNING: Invalid file -- mmapList --\n");
+        close(fd);
+        return NULL;
+    }
+
+    size_t length = (size_t) status.st_size;
+
+    // The mapping stays valid after the file is closed
+    char *base = (char *) mmap(NULL, length, PROT_READ, MAP_SHARED, fd, 0);
+    close(fd);
+
+    if(base == MAP_FAILED) {
+        reportError("ERROR: Could not map file -- mmapList --\n");
+        return NULL;
+    }
+
+    const LISTMAPHEADER *header = (const LISTMAPHEADER *) base;
+
+    // The entries are checked as they are read
+    if(memcmp(header->magic, LIST_MAP_MAGIC, sizeof(header->magic)) || header->version != LIST_MAP_VERSION ||
+       header->entrySize != sizeof(LISTMAPENTRY) || header->length != length || header->size < 0 ||
+       header->entries != sizeof(LISTMAPHEADER) ||
+       (uint64_t) header->size > (length - sizeof(LISTMAPHEADER)) / sizeof(LISTMAPENTRY)) {
+        reportError("WARNING: Invalid file -- mmapList --\n");
+        munmap(base, length);
+        return NULL;
+    }
+
+    MAPPEDLIST *mapped = (MAPPEDLIST *) malloc(sizeof(MAPPEDLIST));
+    if(!mapped) {
+        reportError("ERROR: Could not allocate memory for new MappedList -- mmapList --\n");
+        munmap(base, length);
+        return NULL;
+    }
+
+    mapped->base = base;
+    mapped->length = length;
+    mapped->header = header;
+    mapped->entries = (const LISTMAPENTRY *) (base + header->entries);
+
+    return mapped;
+}
+
+int getMappedListSize(MappedList mlist) {
+    if(PARAMETER_CHECK(!mlist)) {
+        reportError("WARNING: Invalid parameter -- getMappedListSize --\n");
+        return 0;
+    }
+
+    MAPPEDLIST *mapped = (MAPPEDLIST *) mlist;
+
+    return mapped->header->size;
+}
+
+ListElement getMappedListElement(MappedList mlist, int position, size_t *size) {
+    if(PARAMETER_CHECK(!mlist)) {
+        reportError("WARNING: Invalid parameter -- getMappedListElement --\n");
+        return NULL;
+    }
+
+    MAPPEDLIST *mapped = (MAPPEDLIST *) mlist;
+
+    if(position < 0 || position >= mapped->header->size) return NULL;
+
+    const LISTMAPENTRY *entry = &mapped->entries[position];
+    if(!isListMapEntryValid(mapped, entry)) {
+        reportError("WARNING: Invalid entry in file -- getMappedListElement --\n");
+        return NULL;
+    }
+
+    if(size) *size = entry->elementSize;
+
+    return mapped->base + entry->element;
+}
+
+void traverseMappedList(MappedList mlist, VisitMappedListElement visit, void *extra) {
+    if(PARAMETER_CHECK(!mlist || !visit)) {
+        reportError("WARNING: Invalid parameters -- traverseMappedList --\n");
+        return;
+    }
+
+    MAPPEDLIST *mapped = (MAPPEDLIST *) mlist;
+
+    for(int i = 0; i < mapped->header->size; i++) {
+        if(!isListMapEntryValid(mapped, &mapped->entries[i])) {
+            reportError("WARNING: Invalid entry in file -- traverseMappedList --\n");
+            return;
+        }
+
+        if(visit(mlist, mapped->base + mapped->entries[i].element, mapped->entries[i].elementSize, extra)) return;
+    }
+}
+
+void closeMappedList(MappedList mlist) {
+    if(!mlist) return;
+
+    MAPPEDLIST *mapped = (MAPPEDLIST *) mlist;
+
+    munmap(mapped->base, mapped->length);
+    free(mapped);
+
+    mlist = NULL;
+}
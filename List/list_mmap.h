@@ -0,0 +1,131 @@
+#ifndef LIST_MMAP_H
+#define LIST_MMAP_H
+
+/*
+    - This module saves a List to a file and maps the file back in memory as a read-only
+      MappedList, so a process can use a list without rebuilding it
+
+    - The file holds no pointers, it is used as it is once mapped:
+        - A header, then an array with an entry for each element, in list order
+        - Entries locate their element by its offset from the start of the file, the bytes of
+          each element are aligned to 8 bytes
+
+    - Elements are saved as the bytes given by a SerializeListElement function. The elements read
+      from a MappedList are pointers to those bytes inside the mapping, so elements stored as plain
+      data (numbers, structs without pointers, strings) can be read directly
+
+    - Opening a MappedList only checks the header, the entries are read from the file as they are
+      used and the pages are shared with every process that maps the same file. Each entry is
+      checked when it is read, functions that reach an invalid entry report a warning and stop
+
+    - Files are read by machines with the same byte order and integer sizes as the one that wrote them
+
+    - Each element of a MappedList has a position inside the interval [0, size), any element
+      can be read in O(1) by its position
+
+    - In this module its assumed MappedList != NULL for functions that recieve it as parameter
+
+    - Parameter checks are compiled out when DS_NO_CHECKS is defined (see Common/error.h)
+
+    - It's necessary to close a MappedList using the functions provided in this module
+*/
+
+#include <stdbool.h>
+#include <stddef.h>
+
+#include "list.h"
+
+typedef void *MappedList;
+
+/*
+    - Function utilized by saveList to get the bytes saved for element
+
+    - Returns a pointer to the bytes and stores their number in size, the bytes
+      must stay valid until the next call. Returns NULL if element can't be saved
+
+    - Ex: For elements pointing to a long, returns element and stores sizeof(long) in size
+*/
+typedef const void *(* SerializeListElement)(ListElement element, size_t *size, void *extra);
+
+/*
+    - Function utilized by traverseMappedList
+
+    - element points to the size bytes saved for the element
+
+    - If this function returns true, the traversal will stop
+*/
+typedef bool (* VisitMappedListElement)(MappedList mlist, ListElement element, size_t size, void *extra);
+
+/*
+    # Input:
+        - list: dll
+        - path: Path of the file, it is replaced if it exists
+        - serialize: Function that gives the bytes saved for each element
+        - extra: Extra pointer given to serialize if necessary
+
+    # Description:
+        - Saves the elements of list, in order, to the file at path
+
+        - Returns false if the file could not be written, the file is then removed
+*/
+bool saveList(List list, const char *path, SerializeListElement serialize, void *extra);
+
+/*
+    # Input:
+        - path: Path of a file written by saveList
+
+    # Description:
+        - Maps the file at path in memory and returns a pointer to a new MappedList
+          that reads it, without parsing or copying the entries
+
+        - Returns NULL if the file could not be mapped or is not a valid file
+*/
+MappedList mmapList(const char *path);
+
+/*
+    # Input:
+        - mlist: MappedList
+
+    # Description:
+        - Returns the number of elements stored in mlist
+*/
+int getMappedListSize(MappedList mlist);
+
+/*
+    # Input:
+        - mlist: MappedList
+        - position: Position of the element
+        - size: Where the size in bytes of the element is stored, can be NULL
+
+    # Description:
+        - Returns the element at position, in O(1)
+
+        - If position is outside [0, size) or the entry is invalid, returns NULL
+*/
+ListElement getMappedListElement(MappedList mlist, int position, size_t *size);
+
+/*
+    # Input:
+        - mlist: MappedList
+        - visit: Function called for every element, from first to last
+        - extra: Extra pointer if necessary
+
+    # Description:
+        - Traverse mlist in order, reading the entries sequentially,
+          until an invalid entry is reached
+
+        - extra can be NULL
+*/
+void traverseMappedList(MappedList mlist, VisitMappedListElement visit, void *extra);
+
+/*
+    # Input:
+        - mlist: MappedList
+
+    # Description:
+        - Unmaps the file and frees the memory used by mlist, the elements
+          read from mlist can't be used afterwards
+*/
+void closeMappedList(MappedList mlist);
+
+#endif
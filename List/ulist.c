@@ -0,0 +1,373 @@
+#include <stdlib.h>
+#include <string.h>
+
+#include "ulist.h"
+#include "../Common/error.h"
+
+typedef struct ulistblock {
+    int count;
+    struct ulistblock *previous, *next;
+    ListElement elements[ULIST_BLOCK_CAPACITY];
+}ULISTBLOCK;
+
+typedef struct {
+    int size;
+    ULISTBLOCK *head, *tail;
+    Pool pool;
+}ULIST;
+
+UList newUList() {
+    ULIST *ul = (ULIST *) malloc(sizeof(ULIST));
+    if(!ul) {
+        reportError("ERROR: Could not allocate memory for new ulist -- newUList --\n");
+        return NULL;
+    }
+
+    ul->pool = newPool(sizeof(ULISTBLOCK), NULL, NULL, NULL);
+    if(!ul->pool) {
+        reportError("ERROR: Could not allocate memory for new ulist -- newUList --\n");
+        free(ul);
+        return NULL;
+    }
+
+    ul->size = 0;
+    ul->head = NULL;
+    ul->tail = NULL;
+
+    return ul;
+}
+
+bool isUListEmpty(UList ulist) {
+    if(PARAMETER_CHECK(!ulist)) {
+        reportError("WARNING: Invalid parameter -- isUListEmpty --\n");
+        return true;
+    }
+
+    return getUListSize(ulist) == 0;
+}
+
+int getUListSize(UList ulist) {
+    if(PARAMETER_CHECK(!ulist)) {
+        reportError("WARNING: Invalid parameter -- getUListSize --\n");
+        return 0;
+    }
+
+    ULIST *ul = (ULIST *) ulist;
+
+    return ul->size;
+}
+
+/*
+    # Input:
+        - ul: ulist
+        - previous: Block after which the new block is linked, NULL to link it as head
+    
+    # Description:
+        - Returns a pointer to a new empty block linked after previous
+*/
+ULISTBLOCK *newUListBlock(ULIST *ul, ULISTBLOCK *previous) {
+    ULISTBLOCK *block = (ULISTBLOCK *) allocatePool(ul->pool);
+    if(!block) {
+        reportError("ERROR: Could not allocate memory for new ulist block -- newUListBlock --\n");
+        return NULL;
+    }
+
+    block->count = 0;
+    block->previous = previous;
+    block->next = (previous) ? previous->next : ul->head;
+
+    if(block->previous) block->previous->next = block;
+    else ul->head = block;
+
+    if(block->next) block->next->previous = block;
+    else ul->tail = block;
+
+    return block;
+}
+
+/*
+    # Input:
+        - ul: ulist
+        - block: Block from ul
+    
+    # Description:
+        - Unlinks block from ul and frees it
+*/
+void freeUListBlock(ULIST *ul, ULISTBLOCK *block) {
+    if(block->previous) block->previous->next = block->next;
+    else ul->head = block->next;
+
+    if(block->next) block->next->previous = block->previous;
+    else ul->tail = block->previous;
+
+    freePool(ul->pool, block);
+}
+
+/*
+    # Input:
+        - ul: ulist
+        - position: Position inside [0, ul.size]
+        - index: Receives the index of position inside the returned block
+    
+    # Description:
+        - Returns the block that holds position, walking from the closest end of ul
+
+        - If position == ul.size, returns the tail block and index == tail.count
+*/
+ULISTBLOCK *findUListBlock(ULIST *ul, int position, int *index) {
+    ULISTBLOCK *block;
+
+    if(position <= ul->size / 2) {
+        for(block = ul->head; position >= block->count && block->next; block = block->next) position -= block->count;
+    }
+    else {
+        position = ul->size - position;
+        for(block = ul->tail; position > block->count; block = block->previous) position -= block->count;
+        position = block->count - position;
+    }
+
+    *index = position;
+
+    return block;
+}
+
+/*
+    # Input:
+        - ul: ulist
+        - block: Block from ul, can be full
+        - index: Index inside block to place element
+        - element: Element to be stored
+    
+    # Description:
+        - Inserts element at index inside block, splitting block in
+          two halves if it is full
+
+        - Returns false if a new block could not be allocated
+*/
+bool insertUListBlockElement(ULIST *ul, ULISTBLOCK *block, int index, ListElement element) {
+    if(block->count == ULIST_BLOCK_CAPACITY) {
+        ULISTBLOCK *half = newUListBlock(ul, block);
+        if(!half) return false;
+
+        // Move the upper half of block to the new block
+        half->count = ULIST_BLOCK_CAPACITY / 2;
+        block->count = ULIST_BLOCK_CAPACITY - half->count;
+        memcpy(half->elements, block->elements + block->count, half->count * sizeof(ListElement));
+
+        if(index > block->count) {
+            index -= block->count;
+            block = half;
+        }
+    }
+
+    memmove(block->elements + index + 1, block->elements + index, (block->count - index) * sizeof(ListElement));
+    block->elements[index] = element;
+    block->count++;
+
+    ul->size++;
+
+    return true;
+}
+
+/*
+    # Input:
+        - ul: ulist
+        - block: Block from ul
+        - index: Index inside block of the element to be removed
+    
+    # Description:
+        - Removes the element at index from block and returns it
+
+        - Empty blocks are freed and sparse blocks are merged with a neighbour
+*/
+ListElement removeUListBlockElement(ULIST *ul, ULISTBLOCK *block, int index) {
+    ListElement element = block->elements[index];
+
+    block->count--;
+    memmove(block->elements + index, block->elements + index + 1, (block->count - index) * sizeof(ListElement));
+
+    ul->size--;
+
+    if(!block->count) {
+        freeUListBlock(ul, block);
+        return element;
+    }
+
+    // Merge sparse blocks, leaving room so the merged block is not split right away
+    if(block->count < ULIST_BLOCK_CAPACITY / 4) {
+        ULISTBLOCK *first = NULL;
+
+        if(block->next && block->count + block->next->count <= ULIST_BLOCK_CAPACITY * 3 / 4) first = block;
+        else if(block->previous && block->count + block->previous->count <= ULIST_BLOCK_CAPACITY * 3 / 4) first = block->previous;
+
+        if(first) {
+            ULISTBLOCK *second = first->next;
+
+            memcpy(first->elements + first->count, second->elements, second->count * sizeof(ListElement));
+            first->count += second->count;
+
+            freeUListBlock(ul, second);
+        }
+    }
+
+    return element;
+}
+
+bool pushUList(UList ulist, ListElement element) {
+    if(PARAMETER_CHECK(!ulist || !element)) {
+        reportError("WARNING: Invalid parameters -- pushUList --\n");
+        return false;
+    }
+
+    ULIST *ul = (ULIST *) ulist;
+
+    // Start a new block instead of splitting a full head, so pushes fill blocks completely
+    if((!ul->head || ul->head->count == ULIST_BLOCK_CAPACITY) && !newUListBlock(ul, NULL)) return false;
+
+    return insertUListBlockElement(ul, ul->head, 0, element);
+}
+
+bool insertEndUList(UList ulist, ListElement element) {
+    if(PARAMETER_CHECK(!ulist || !element)) {
+        reportError("WARNING: Invalid parameters -- insertEndUList --\n");
+        return false;
+    }
+
+    ULIST *ul = (ULIST *) ulist;
+
+    // Start a new block instead of splitting a full tail, so appends fill blocks completely
+    if((!ul->tail || ul->tail->count == ULIST_BLOCK_CAPACITY) && !newUListBlock(ul, ul->tail)) return false;
+
+    return insertUListBlockElement(ul, ul->tail, ul->tail->count, element);
+}
+
+bool insertUList(UList ulist, ListElement element, int position) {
+    if(PARAMETER_CHECK(!ulist || !element)) {
+        reportError("WARNING: Invalid parameters -- insertUList --\n");
+        return false;
+    }
+
+    ULIST *ul = (ULIST *) ulist;
+
+    if(position == 0) return pushUList(ulist, element);
+    if(position >= ul->size || position < 0) return insertEndUList(ulist, element);
+
+    int index;
+    ULISTBLOCK *block = findUListBlock(ul, position, &index);
+
+    return insertUListBlockElement(ul, block, index, element);
+}
+
+ListElement popUList(UList ulist) {
+    if(PARAMETER_CHECK(!ulist)) {
+        reportError("WARNING: Invalid parameter -- popUList --\n");
+        return NULL;
+    }
+
+    ULIST *ul = (ULIST *) ulist;
+
+    if(!ul->size) return NULL;
+
+    return removeUListBlockElement(ul, ul->head, 0);
+}
+
+ListElement popEndUList(UList ulist) {
+    if(PARAMETER_CHECK(!ulist)) {
+        reportError("WARNING: Invalid parameter -- popEndUList --\n");
+        return NULL;
+    }
+
+    ULIST *ul = (ULIST *) ulist;
+
+    if(!ul->size) return NULL;
+
+    return removeUListBlockElement(ul, ul->tail, ul->tail->count - 1);
+}
+
+ListElement removeUList(UList ulist, int position) {
+    if(PARAMETER_CHECK(!ulist)) {
+        reportError("WARNING: Invalid parameter -- removeUList --\n");
+        return NULL;
+    }
+
+    ULIST *ul = (ULIST *) ulist;
+
+    if(!ul->size) return NULL;
+    if(position >= ul->size - 1 || position < 0) return popEndUList(ulist);
+
+    int index;
+    ULISTBLOCK *block = findUListBlock(ul, position, &index);
+
+    return removeUListBlockElement(ul, block, index);
+}
+
+ListElement getUListElement(UList ulist, int position) {
+    if(PARAMETER_CHECK(!ulist)) {
+        reportError("WARNING: Invalid parameter -- getUListElement --\n");
+        return NULL;
+    }
+
+    ULIST *ul = (ULIST *) ulist;
+
+    if(PARAMETER_CHECK(position < 0 || position >= ul->size)) {
+        reportError("WARNING: Invalid position -- getUListElement --\n");
+        return NULL;
+    }
+
+    int index;
+    ULISTBLOCK *block = findUListBlock(ul, position, &index);
+
+    return block->elements[index];
+}
+
+ListElement getFirstUListElement(UList ulist) {
+    if(PARAMETER_CHECK(!ulist)) {
+        reportError("WARNING: Invalid parameter -- getFirstUListElement --\n");
+        return NULL;
+    }
+
+    ULIST *ul = (ULIST *) ulist;
+
+    if(!ul->size) return NULL;
+
+    return ul->head->elements[0];
+}
+
+ListElement getLastUListElement(UList ulist) {
+    if(PARAMETER_CHECK(!ulist)) {
+        reportError("WARNING: Invalid parameter -- getLastUListElement --\n");
+        return NULL;
+    }
+
+    ULIST *ul = (ULIST *) ulist;
+
+    if(!ul->size) return NULL;
+
+    return ul->tail->elements[ul->tail->count - 1];
+}
+
+void traverseUList(UList ulist, VisitUListElement visit, void *extra) {
+    if(PARAMETER_CHECK(!ulist || !visit)) {
+        reportError("WARNING: Invalid parameters -- traverseUList --\n");
+        return;
+    }
+
+    ULIST *ul = (ULIST *) ulist;
+
+    for(ULISTBLOCK *block = ul->head; block; block = block->next) {
+        for(int i = 0; i < block->count; i++) {
+            if(visit(ulist, block->elements[i], extra)) return;
+        }
+    }
+}
+
+void destroyUList(UList ulist) {
+    if(!ulist) return;
+
+    ULIST *ul = (ULIST *) ulist;
+
+    destroyPool(ul->pool);
+
+    free(ul);
+    ulist = NULL;
+}
@@ -0,0 +1,203 @@
+#ifndef ULIST_H
+#define ULIST_H
+
+/*
+    - This module implements an unrolled linked list(ulist)
+
+    - An ulist is a doubly linked list of blocks, each block stores up to ULIST_BLOCK_CAPACITY
+      ListElements in a contiguous array. Scanning the list touches one block per
+      ULIST_BLOCK_CAPACITY elements instead of one node per element, and there is no per element
+      link overhead.
+
+    - Each element has a position inside the ulist, this position is inside the interval [0, ulist.size)
+
+    - Elements move between blocks when blocks are split or merged, so elements are accessed by
+      position (or traversed) instead of through node handles
+
+    - A valid element is a ListElement != NULL
+
+    - In this module its assumed UList != NULL and ListElement != NULL for functions that recieve
+      those as parameters 
+
+    - Parameter checks are compiled out when DS_NO_CHECKS is defined (see Common/error.h)
+
+    - It's necessary to free the memory allocated for UList using the functions provided in this module
+*/
+
+#include <stdbool.h>
+
+#include "list.h"
+
+// Number of elements stored in each block
+#define ULIST_BLOCK_CAPACITY 32
+
+typedef void *UList;
+
+/*
+    - Function utilized by traverseUList
+
+    - If this function returns true, the traversal will stop
+*/
+typedef bool (* VisitUListElement)(UList ulist, ListElement element, void *extra);
+
+/*
+    # Description:
+        - Returns a pointer to a new empty ulist
+*/
+UList newUList();
+
+/*
+    # Input:
+        - ulist: ulist
+    
+    # Description:
+        - Returns true if ulist is empty, false otherwise
+*/
+bool isUListEmpty(UList ulist);
+
+/*
+    # Input:
+        - ulist: ulist
+    
+    # Description:
+        - Return the number of elements stored in ulist
+*/
+int getUListSize(UList ulist);
+
+/*
+    # Inputs:
+        - ulist: ulist
+        - element: Element to be stored in ulist
+
+    # Description:
+        - Insert element at the start of ulist
+
+        - Returns false if element could not be inserted
+*/
+bool pushUList(UList ulist, ListElement element);
+
+/*
+    # Inputs:
+        - ulist: ulist
+        - element: Element to be stored in ulist
+
+    # Description:
+        - Insert element at the end of ulist
+
+        - Returns false if element could not be inserted
+*/
+bool insertEndUList(UList ulist, ListElement element);
+
+/*
+    # Inputs:
+        - ulist: ulist
+        - element: Element to be stored in ulist
+        - position: Position in ulist to place element
+    
+    # Description:
+        - Insert element at informed position
+
+        - If position >= ulist.size or position == -1, 
+          the element will be positioned at the end
+          of the ulist
+
+        - Returns false if element could not be inserted
+*/
+bool insertUList(UList ulist, ListElement element, int position);
+
+/*
+    # Input:
+        - ulist: ulist
+
+    # Description:
+        - Removes the first element from ulist
+          and returns it
+        
+        - Returns NULL if ulist is empty
+*/
+ListElement popUList(UList ulist);
+
+/*
+    # Input:
+        - ulist: ulist
+
+    # Description:
+        - Removes the last element from ulist
+          and returns it
+        
+        - Returns NULL if ulist is empty
+*/
+ListElement popEndUList(UList ulist);
+
+/*
+    # Inputs:
+        - ulist: ulist
+        - position: Position of the element to be removed
+    
+    # Description:
+        - Remove element at informed position
+
+        - If position >= ulist.size or position == -1, 
+          the last element from ulist will be removed
+
+        - Returns the removed element, or NULL if ulist is empty
+*/
+ListElement removeUList(UList ulist, int position);
+
+/*
+    # Input:
+        - ulist: ulist
+        - position: Position of the element
+
+    # Description:
+        - Returns the element stored at position
+
+        - position must be inside [0, ulist.size)
+*/
+ListElement getUListElement(UList ulist, int position);
+
+/*
+    # Input:
+        - ulist: ulist
+    
+    # Description:
+        - Returns the first element from ulist
+
+        - Returns NULL if ulist is empty
+*/
+ListElement getFirstUListElement(UList ulist);
+
+/*
+    # Input:
+        - ulist: ulist
+    
+    # Description:
+        - Returns the last element from ulist
+
+        - Returns NULL if ulist is empty
+*/
+ListElement getLastUListElement(UList ulist);
+
+/*
+    # Input:
+        - ulist: ulist
+        - visit: Function called for every element, from first to last
+        - extra: Extra pointer if necessary
+    
+    # Description:
+        - Traverse ulist in order
+
+        - extra can be NULL
+*/
+void traverseUList(UList ulist, VisitUListElement visit, void *extra);
+
+/*
+    # Input:
+        - ulist: ulist
+    
+    # Description:
+        - Free all the memory used by ulist
+*/
+void destroyUList(UList ulist);
+
+#endif
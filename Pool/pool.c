@@ -0,0 +1,269 @@
+#include <stdlib.h>
+
+#include "pool.h"
+#include "../Common/error.h"
+
+// Number of objects in the first slab, each new slab doubles it up to POOL_MAX_SLAB_OBJECTS
+#define POOL_MIN_SLAB_OBJECTS 32
+#define POOL_MAX_SLAB_OBJECTS 4096
+
+// Objects and slab headers are aligned to the strictest alignment of these types
+typedef union {
+    void *pointer;
+    long long integer;
+    double real;
+} POOLALIGNMENT;
+
+#define POOL_ALIGN(size) (((size) + sizeof(POOLALIGNMENT) - 1) / sizeof(POOLALIGNMENT) * sizeof(POOLALIGNMENT))
+
+typedef struct poolslab {
+    struct poolslab *next;
+} POOLSLAB;
+
+typedef struct poolobject {
+    struct poolobject *next;
+} POOLOBJECT;
+
+typedef struct {
+    size_t objectSize;
+    int slabObjects;
+    AllocateMemory allocate;
+    FreeMemory release;
+    void *extra;
+    POOLSLAB *slabs;
+    POOLOBJECT *freeObjects;
+    char *nextObject, *slabEnd;
+
+    // Number of owners of the pool, the memory is freed when the last one destroys it
+    int references;
+} POOL;
+
+/*
+    # Description:
+        - Default AllocateMemory, uses malloc
+*/
+void *allocatePoolMemory(size_t size, void *extra) {
+    (void) extra;
+
+    return malloc(size);
+}
+
+/*
+    # Description:
+        - Default FreeMemory, uses free
+*/
+void freePoolMemory(void *memory, void *extra) {
+    (void) extra;
+
+    free(memory);
+}
+
+Pool newPool(size_t objectSize, AllocateMemory allocate, FreeMemory release, void *extra) {
+    if(PARAMETER_CHECK(!objectSize || (!allocate != !release))) {
+        reportError("WARNING: Invalid parameters -- newPool --\n");
+        return NULL;
+    }
+
+    POOL *pool = (POOL *) malloc(sizeof(POOL));
+    if(!pool) {
+        reportError("ERROR: Could not allocate memory for new pool -- newPool --\n");
+        return NULL;
+    }
+
+    // Freed objects store the free list link inside themselves
+    if(objectSize < sizeof(POOLOBJECT)) objectSize = sizeof(POOLOBJECT);
+
+    pool->objectSize = POOL_ALIGN(objectSize);
+    pool->slabObjects = POOL_MIN_SLAB_OBJECTS;
+    pool->allocate = (allocate) ? allocate : allocatePoolMemory;
+    pool->release = (release) ? release : freePoolMemory;
+    pool->extra = extra;
+    pool->slabs = NULL;
+    pool->freeObjects = NULL;
+    pool->nextObject = NULL;
+    pool->slabEnd = NULL;
+    pool->references = 1;
+
+    return pool;
+}
+
+/*
+    # Input:
+        - pool: Pool
+        - objects: Number of objects in the new slab
+    
+    # Description:
+        - Allocates a new slab for pool and makes it the slab new objects are carved from
+
+        - Returns false if memory could not be allocated
+*/
+bool addPoolSlab(POOL *pool, size_t objects) {
+    size_t headerSize = POOL_ALIGN(sizeof(POOLSLAB));
+
+    POOLSLAB *slab = (POOLSLAB *) pool->allocate(headerSize + pool->objectSize * objects, pool->extra);
+    if(!slab) {
+        reportError("ERROR: Could not allocate memory for new slab -- addPoolSlab --\n");
+        return false;
+    }
+
+    slab->next = pool->slabs;
+    pool->slabs = slab;
+
+    pool->nextObject = (char *) slab + headerSize;
+    pool->slabEnd = pool->nextObject + pool->objectSize * objects;
+
+    return true;
+}
+
+void *allocatePool(Pool pool) {
+    if(PARAMETER_CHECK(!pool)) {
+        reportError("WARNING: Invalid parameter -- allocatePool --\n");
+        return NULL;
+    }
+
+    POOL *pl = (POOL *) pool;
+
+    // Reuse freed objects first
+    if(pl->freeObjects) {
+        POOLOBJECT *object = pl->freeObjects;
+        pl->freeObjects = object->next;
+
+        return object;
+    }
+
+    if(pl->nextObject == pl->slabEnd) {
+        if(!addPoolSlab(pl, pl->slabObjects)) return NULL;
+
+        if(pl->slabObjects < POOL_MAX_SLAB_OBJECTS) pl->slabObjects *= 2;
+    }
+
+    void *object = pl->nextObject;
+    pl->nextObject += pl->objectSize;
+
+    return object;
+}
+
+bool reservePool(Pool pool, size_t count) {
+    if(PARAMETER_CHECK(!pool)) {
+        reportError("WARNING: Invalid parameter -- reservePool --\n");
+        return false;
+    }
+
+    POOL *pl = (POOL *) pool;
+
+    if((size_t) (pl->slabEnd - pl->nextObject) / pl->objectSize >= count) return true;
+
+    return addPoolSlab(pl, count);
+}
+
+void freePool(Pool pool, void *object) {
+    if(PARAMETER_CHECK(!pool || !object)) {
+        reportError("WARNING: Invalid parameters -- freePool --\n");
+        return;
+    }
+
+    POOL *pl = (POOL *) pool;
+    POOLOBJECT *obj = (POOLOBJECT *) object;
+
+    obj->next = pl->freeObjects;
+    pl->freeObjects = obj;
+}
+
+void releasePool(Pool pool) {
+    if(PARAMETER_CHECK(!pool)) {
+        reportError("WARNING: Invalid parameter -- releasePool --\n");
+        return;
+    }
+
+    POOL *pl = (POOL *) pool;
+
+    while(pl->slabs) {
+        POOLSLAB *slab = pl->slabs;
+        pl->slabs = slab->next;
+
+        pl->release(slab, pl->extra);
+    }
+
+    pl->slabObjects = POOL_MIN_SLAB_OBJECTS;
+    pl->freeObjects = NULL;
+    pl->nextObject = NULL;
+    pl->slabEnd = NULL;
+}
+
+bool mergePool(Pool pool, Pool other) {
+    if(PARAMETER_CHECK(!pool || !other)) {
+        reportError("WARNING: Invalid parameters -- mergePool --\n");
+        return false;
+    }
+
+    POOL *pl = (POOL *) pool;
+    POOL *ol = (POOL *) other;
+
+    if(pl == ol) return true;
+
+    // The slabs of other must be freed the same way as the slabs of pool
+    if(pl->objectSize != ol->objectSize || pl->allocate != ol->allocate || pl->release != ol->release ||
+       pl->extra != ol->extra || ol->references > 1) return false;
+
+    if(ol->slabs) {
+        POOLSLAB *last;
+        for(last = ol->slabs; last->next; last = last->next);
+
+        last->next = pl->slabs;
+        pl->slabs = ol->slabs;
+    }
+
+    if(ol->freeObjects) {
+        POOLOBJECT *last;
+        for(last = ol->freeObjects; last->next; last = last->next);
+
+        last->next = pl->freeObjects;
+        pl->freeObjects = ol->freeObjects;
+    }
+
+    // Objects never handed out by other stay unused until the slabs are released
+    ol->slabObjects = POOL_MIN_SLAB_OBJECTS;
+    ol->slabs = NULL;
+    ol->freeObjects = NULL;
+    ol->nextObject = NULL;
+    ol->slabEnd = NULL;
+
+    return true;
+}
+
+Pool sharePool(Pool pool) {
+    if(PARAMETER_CHECK(!pool)) {
+        reportError("WARNING: Invalid parameter -- sharePool --\n");
+        return NULL;
+    }
+
+    POOL *pl = (POOL *) pool;
+    pl->references++;
+
+    return pool;
+}
+
+bool isPoolShared(Pool pool) {
+    if(PARAMETER_CHECK(!pool)) {
+        reportError("WARNING: Invalid parameter -- isPoolShared --\n");
+        return false;
+    }
+
+    POOL *pl = (POOL *) pool;
+
+    return pl->references > 1;
+}
+
+void destroyPool(Pool pool) {
+    if(!pool) return;
+
+    POOL *pl = (POOL *) pool;
+
+    // Other owners still use the objects of the pool
+    if(--pl->references) return;
+
+    releasePool(pool);
+
+    free(pool);
+    pool = NULL;
+}
@@ -0,0 +1,163 @@
+#ifndef POOL_H
+#define POOL_H
+
+/*
+    - This module implements a fixed-size object pool
+
+    - A pool hands out objects of a single size. Objects are carved from large slabs of memory
+      and freed objects are kept in a free list to be reused by the next allocation, so allocating
+      and freeing an object are O(1) and objects allocated together stay close in memory.
+
+    - All the objects of a pool can be released at once with releasePool, which frees the slabs
+      instead of each object
+
+    - The memory for the slabs can come from user supplied AllocateMemory and FreeMemory functions,
+      if those are NULL malloc and free are used
+
+    - A pool can have several owners (see sharePool), so objects can move between the structures
+      that allocate from it. The pool is freed when its last owner destroys it
+
+    - In this module its assumed Pool != NULL for functions that recieve it as parameter
+
+    - Parameter checks are compiled out when DS_NO_CHECKS is defined (see Common/error.h)
+
+    - It's necessary to free the memory allocated for Pool using the functions provided in this module
+*/
+
+#include <stdbool.h>
+#include <stddef.h>
+
+typedef void *Pool;
+
+/*
+    - Function used by a pool to allocate a slab of size bytes
+
+    - extra is the pointer given when the pool was created
+
+    - Returns NULL if the memory could not be allocated
+*/
+typedef void *(* AllocateMemory)(size_t size, void *extra);
+
+/*
+    - Function used by a pool to free a slab allocated by AllocateMemory
+
+    - extra is the pointer given when the pool was created
+*/
+typedef void (* FreeMemory)(void *memory, void *extra);
+
+/*
+    # Input:
+        - objectSize: Size in bytes of the objects handed out by the pool
+        - allocate: Function used to allocate slabs, can be NULL
+        - release: Function used to free slabs, can be NULL
+        - extra: Extra pointer given to allocate and release if necessary
+    
+    # Description:
+        - Returns a pointer to a new empty pool
+
+        - allocate and release must be both NULL or both != NULL
+*/
+Pool newPool(size_t objectSize, AllocateMemory allocate, FreeMemory release, void *extra);
+
+/*
+    # Input:
+        - pool: Pool
+    
+    # Description:
+        - Returns a pointer to an uninitialized object from pool
+
+        - Returns NULL if memory could not be allocated
+*/
+void *allocatePool(Pool pool);
+
+/*
+    # Input:
+        - pool: Pool
+        - count: Number of objects
+    
+    # Description:
+        - Makes sure the next count objects carved from new memory are
+          contiguous, allocating a single slab for all of them if the
+          current slab doesn't have room
+
+        - Objects returned to the pool with freePool are still reused first
+
+        - Returns false if memory could not be allocated
+*/
+bool reservePool(Pool pool, size_t count);
+
+/*
+    # Input:
+        - pool: Pool
+        - object: Object allocated from pool
+    
+    # Description:
+        - Returns object to pool so it can be reused
+*/
+void freePool(Pool pool, void *object);
+
+/*
+    # Input:
+        - pool: Pool
+    
+    # Description:
+        - Frees every object allocated from pool at once
+
+        - The cost depends on the number of slabs, not on the number of objects
+
+        - pool remains valid and can be used for new allocations
+*/
+void releasePool(Pool pool);
+
+/*
+    # Input:
+        - pool: Pool
+        - other: Pool
+    
+    # Description:
+        - Moves every object allocated from other, and the memory holding them,
+          to pool. The objects stay where they are and become objects of pool,
+          other is left empty and can still be used
+
+        - The cost depends on the number of slabs and freed objects of other,
+          not on the number of objects in use
+
+        - Returns false, and changes nothing, if other has more than one owner
+          or its objects can't be freed by pool (different object size or
+          memory functions)
+*/
+bool mergePool(Pool pool, Pool other);
+
+/*
+    # Input:
+        - pool: Pool
+    
+    # Description:
+        - Adds an owner to pool and returns pool
+
+        - Each owner must call destroyPool once
+*/
+Pool sharePool(Pool pool);
+
+/*
+    # Input:
+        - pool: Pool
+    
+    # Description:
+        - Returns true if pool has more than one owner, false otherwise
+*/
+bool isPoolShared(Pool pool);
+
+/*
+    # Input:
+        - pool: Pool
+    
+    # Description:
+        - Drops an owner of pool
+
+        - When the last owner is dropped, frees all the memory used by pool,
+          including every object allocated from it
+*/
+void destroyPool(Pool pool);
+
+#endif